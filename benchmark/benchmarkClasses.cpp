@@ -0,0 +1,88 @@
+#include "benchmarkClasses.h"
+#include <reflection/reflection.h>
+
+#include <utility>
+
+namespace {
+
+#define REGISTER_FIELD(name, index)      FIELD(name);
+#define REGISTER_ENUMERATOR(name, index) ENUMERATOR(name)
+#define REGISTER_FLAG(name, index)       BITMASK_VALUE(name)
+
+template <int Depth>
+void registerNested() {
+	if constexpr (Depth > 0) {
+		registerNested<Depth - 1>();
+	}
+	BEGIN_REFLECTION()
+	BEGIN_STRUCT(Nested<Depth>);
+	FIELD(value);
+	if constexpr (Depth > 0) {
+		FIELD(child);
+		FIELD(name);
+	}
+	END_STRUCT();
+	END_REFLECTION();
+}
+
+template <int N>
+void registerTag(refl::Context& context) {
+	using namespace refl;
+	// Give each type its own name, so that lookups by name can be measured too
+	const char* typeName = detail::decorateTypeName(std::to_string(N), "Tag<", ">", *context.scopedAllocator);
+	const auto  tagType = context.scopedAllocator->make<StructType>(typeName, Typhoon::getTypeId<Tag<N>>(), sizeof(Tag<N>), alignof(Tag<N>), nullptr,
+                                                                   detail::buildMethodTable<Tag<N>>(), *context.allocator);
+	tagType->addProperty(detail::ClassUtil<Tag<N>>::makeProperty("value", &Tag<N>::value, context));
+	context.typeDB->registerType(tagType);
+}
+
+template <int... N>
+void registerTags(refl::Context& context, std::integer_sequence<int, N...>) {
+	(registerTag<N>(context), ...);
+}
+
+template <class T>
+void registerContainer(refl::Context& context) {
+	// Containers are registered when first used. Do it now, as lookups might be measured on a frozen registry
+	refl::detail::autoRegisterType<T>(context);
+}
+
+} // namespace
+
+void registerBenchmarkTypes() {
+	BEGIN_REFLECTION()
+
+	BEGIN_ENUM(AssetKind)
+	BENCHMARK_NAMES(REGISTER_ENUMERATOR)
+	END_ENUM();
+
+	BEGIN_BITMASK(PermissionMask)
+	BENCHMARK_NAMES(REGISTER_FLAG)
+	END_BITMASK();
+
+	BEGIN_STRUCT(WideStruct);
+	BENCHMARK_NAMES(REGISTER_FIELD)
+	END_STRUCT();
+
+	BEGIN_STRUCT(Point);
+	FIELD(x);
+	FIELD(y);
+	FIELD(z);
+	FIELD(id);
+	END_STRUCT();
+
+	BEGIN_STRUCT(Assets);
+	FIELD(kinds);
+	FIELD(permissions);
+	END_STRUCT();
+
+	END_REFLECTION();
+
+	registerNested<nestingDepth>();
+
+	refl::Context& context = refl::detail::getContext();
+	registerTags(context, std::make_integer_sequence<int, tagCount> {});
+	registerContainer<std::vector<float>>(context);
+	registerContainer<std::vector<Point>>(context);
+	registerContainer<std::map<std::string, int>>(context);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <core/bitMask.h>
+#include <reflection/fwdDecl.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Identifiers of wide structs, enumerators and bitmask constants, with their index
+#define BENCHMARK_NAMES(X) \
+	X(v00, 0) X(v01, 1) X(v02, 2) X(v03, 3) X(v04, 4) X(v05, 5) X(v06, 6) X(v07, 7) \
+	X(v08, 8) X(v09, 9) X(v10, 10) X(v11, 11) X(v12, 12) X(v13, 13) X(v14, 14) X(v15, 15) \
+	X(v16, 16) X(v17, 17) X(v18, 18) X(v19, 19) X(v20, 20) X(v21, 21) X(v22, 22) X(v23, 23) \
+	X(v24, 24) X(v25, 25) X(v26, 26) X(v27, 27) X(v28, 28) X(v29, 29) X(v30, 30) X(v31, 31) \
+	X(v32, 32) X(v33, 33) X(v34, 34) X(v35, 35) X(v36, 36) X(v37, 37) X(v38, 38) X(v39, 39) \
+	X(v40, 40) X(v41, 41) X(v42, 42) X(v43, 43) X(v44, 44) X(v45, 45) X(v46, 46) X(v47, 47) \
+	X(v48, 48) X(v49, 49) X(v50, 50) X(v51, 51) X(v52, 52) X(v53, 53) X(v54, 54) X(v55, 55) \
+	X(v56, 56) X(v57, 57) X(v58, 58) X(v59, 59) X(v60, 60) X(v61, 61) X(v62, 62) X(v63, 63)
+
+#define DECLARE_FIELD(name, index)       float name;
+#define DECLARE_ENUMERATOR(name, index)  name,
+#define DECLARE_FLAG(name, index)        name = 1ull << index,
+
+// Struct with many fields, like configuration structs
+struct WideStruct {
+	BENCHMARK_NAMES(DECLARE_FIELD)
+};
+
+enum class AssetKind {
+	BENCHMARK_NAMES(DECLARE_ENUMERATOR)
+};
+
+enum class Permission : uint64_t {
+	BENCHMARK_NAMES(DECLARE_FLAG)
+};
+
+using PermissionMask = Typhoon::Bitmask<Permission>;
+
+struct Point {
+	float x;
+	float y;
+	float z;
+	int   id;
+
+	bool operator==(const Point&) const = default;
+};
+
+// Structs nested Depth times
+template <int Depth>
+struct Nested {
+	Nested<Depth - 1> child;
+	float             value;
+	std::string       name;
+};
+
+template <>
+struct Nested<0> {
+	float value;
+};
+
+constexpr int nestingDepth = 16;
+
+struct Assets {
+	std::vector<AssetKind>      kinds;
+	std::vector<PermissionMask> permissions;
+};
+
+// Types registered to measure registry lookups
+template <int N>
+struct Tag {
+	int value;
+};
+
+constexpr int tagCount = 1024;
+
+void registerBenchmarkTypes();
@@ -0,0 +1,257 @@
+#include "harness.h"
+#include <core/allocator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Benchmarks run on the main thread only
+AllocationCounters allocationCounters {};
+
+void* countedAlloc(size_t size) {
+	++allocationCounters.count;
+	allocationCounters.bytes += size;
+	if (void* ptr = std::malloc(size ? size : 1); ptr) {
+		return ptr;
+	}
+	std::abort(); // exceptions are disabled
+}
+
+void* countedAlignedAlloc(size_t size, std::align_val_t alignment) {
+	++allocationCounters.count;
+	allocationCounters.bytes += size;
+	const size_t align = static_cast<size_t>(alignment);
+#ifdef _MSC_VER
+	void* ptr = _aligned_malloc(size ? size : 1, align);
+#else
+	void* ptr = std::aligned_alloc(align, (std::max(size, size_t { 1 }) + align - 1) & ~(align - 1));
+#endif
+	if (! ptr) {
+		std::abort();
+	}
+	return ptr;
+}
+
+void alignedFree(void* ptr) {
+#ifdef _MSC_VER
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+
+class CountingAllocator final : public Typhoon::Allocator {
+public:
+	void* alloc(size_t size, size_t alignment) override {
+		++allocationCounters.count;
+		allocationCounters.bytes += size;
+		return heapAllocator.alloc(size, alignment);
+	}
+
+	void free(void* ptr, size_t size) override {
+		heapAllocator.free(ptr, size);
+	}
+
+	void* realloc(void* ptr, size_t bytes, size_t alignment) override {
+		++allocationCounters.count;
+		allocationCounters.bytes += bytes;
+		return heapAllocator.realloc(ptr, bytes, alignment);
+	}
+
+private:
+	Typhoon::HeapAllocator heapAllocator;
+};
+
+const char* getConfiguration() {
+#ifdef NDEBUG
+	return "release";
+#else
+	return "debug";
+#endif
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+	return countedAlloc(size);
+}
+
+void* operator new[](size_t size) {
+	return countedAlloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+	return countedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+	return countedAlignedAlloc(size, alignment);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return countedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return countedAlloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return countedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return countedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+	alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+	alignedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+	alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+	alignedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+	alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+	alignedFree(ptr);
+}
+
+AllocationCounters getAllocationCounters() {
+	return allocationCounters;
+}
+
+Typhoon::Allocator& getCountingAllocator() {
+	static CountingAllocator allocator;
+	return allocator;
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkSettings& settings)
+    : settings { settings } {
+}
+
+bool BenchmarkRunner::isEnabled(std::string_view name) const {
+	return name.find(settings.filter) != std::string_view::npos;
+}
+
+void BenchmarkRunner::measure(std::string_view name, size_t bytesPerOp, SampleFunc sample, void* op) {
+	using Clock = std::chrono::steady_clock;
+	auto runSample = [&](size_t iterations) {
+		const auto start = Clock::now();
+		sample(op, iterations);
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	};
+
+	// Warm up caches and lazily initialized data, then double the iterations until a sample lasts long enough
+	size_t       iterations = 1;
+	const double sampleTimeNs = settings.sampleTimeMs * 1e6;
+	for (double elapsed = runSample(iterations); elapsed < sampleTimeNs && iterations < (size_t { 1 } << 40); elapsed = runSample(iterations)) {
+		iterations *= 2;
+	}
+
+	std::vector<double>      nsPerOp;
+	const AllocationCounters startCounters = getAllocationCounters();
+	for (int s = 0; s < settings.sampleCount; ++s) {
+		nsPerOp.push_back(runSample(iterations) / static_cast<double>(iterations));
+	}
+	const AllocationCounters endCounters = getAllocationCounters();
+
+	std::sort(nsPerOp.begin(), nsPerOp.end());
+	const double opCount = static_cast<double>(iterations) * static_cast<double>(nsPerOp.size());
+	results.push_back({ std::string { name }, iterations, nsPerOp[nsPerOp.size() / 2], nsPerOp.front(), nsPerOp.back(), bytesPerOp,
+	                    static_cast<double>(endCounters.count - startCounters.count) / opCount,
+	                    static_cast<double>(endCounters.bytes - startCounters.bytes) / opCount });
+	if (settings.format != OutputFormat::text) {
+		// Report progress, results are printed at the end
+		std::fprintf(stderr, "%.*s\n", static_cast<int>(name.size()), name.data());
+	}
+}
+
+void BenchmarkRunner::printResults(FILE* file) const {
+	switch (settings.format) {
+	case OutputFormat::text:
+		printText(file);
+		break;
+	case OutputFormat::csv:
+		printCSV(file);
+		break;
+	case OutputFormat::json:
+		printJSON(file);
+		break;
+	}
+}
+
+namespace {
+
+double getMBPerSecond(const BenchmarkResult& result) {
+	return result.bytesPerOp ? static_cast<double>(result.bytesPerOp) / result.nsPerOp * 1e9 / (1024. * 1024.) : 0.;
+}
+
+} // namespace
+
+void BenchmarkRunner::printText(FILE* file) const {
+	std::fprintf(file, "%-36s %14s %12s %12s %14s\n", "benchmark", "ns/op", "ops/s", "MB/s", "allocs/op");
+	for (const BenchmarkResult& r : results) {
+		std::fprintf(file, "%-36s %14.1f %12.0f %12.1f %14.2f\n", r.name.c_str(), r.nsPerOp, 1e9 / r.nsPerOp, getMBPerSecond(r), r.allocationsPerOp);
+	}
+}
+
+void BenchmarkRunner::printCSV(FILE* file) const {
+	std::fprintf(file, "name,iterations,ns_per_op,min_ns_per_op,max_ns_per_op,bytes_per_op,mb_per_s,allocs_per_op,alloc_bytes_per_op\n");
+	for (const BenchmarkResult& r : results) {
+		std::fprintf(file, "%s,%zu,%.3f,%.3f,%.3f,%zu,%.3f,%.3f,%.3f\n", r.name.c_str(), r.iterations, r.nsPerOp, r.minNsPerOp, r.maxNsPerOp,
+		             r.bytesPerOp, getMBPerSecond(r), r.allocationsPerOp, r.allocatedBytesPerOp);
+	}
+}
+
+void BenchmarkRunner::printJSON(FILE* file) const {
+	// Benchmark names don't need escaping
+	std::fprintf(file, "{\n  \"configuration\": \"%s\",\n  \"samples\": %d,\n  \"benchmarks\": [", getConfiguration(), settings.sampleCount);
+	for (size_t i = 0; i < results.size(); ++i) {
+		const BenchmarkResult& r = results[i];
+		std::fprintf(file,
+		             "%s\n    { \"name\": \"%s\", \"iterations\": %zu, \"nsPerOp\": %.3f, \"minNsPerOp\": %.3f, \"maxNsPerOp\": %.3f, "
+		             "\"bytesPerOp\": %zu, \"mbPerSecond\": %.3f, \"allocsPerOp\": %.3f, \"allocBytesPerOp\": %.3f }",
+		             i ? "," : "", r.name.c_str(), r.iterations, r.nsPerOp, r.minNsPerOp, r.maxNsPerOp, r.bytesPerOp, getMBPerSecond(r),
+		             r.allocationsPerOp, r.allocatedBytesPerOp);
+	}
+	std::fprintf(file, "\n  ]\n}\n");
+}
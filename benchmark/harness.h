@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Typhoon {
+
+class Allocator;
+
+}
+
+// Allocations made since the program started, through the global operator new and the allocator returned by getCountingAllocator
+struct AllocationCounters {
+	size_t count;
+	size_t bytes;
+};
+
+AllocationCounters  getAllocationCounters();
+Typhoon::Allocator& getCountingAllocator();
+
+// Prevent the compiler from optimizing away the computation of value
+template <class T>
+inline void doNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+	const volatile char* ptr = reinterpret_cast<const volatile char*>(&value);
+	static_cast<void>(*ptr);
+#else
+	asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+enum class OutputFormat {
+	text,
+	csv,
+	json,
+};
+
+struct BenchmarkSettings {
+	std::string  filter;             // run benchmarks whose name contains this string
+	double       sampleTimeMs = 20.; // minimum duration of a sample
+	int          sampleCount = 11;
+	OutputFormat format = OutputFormat::text;
+};
+
+struct BenchmarkResult {
+	std::string name;
+	size_t      iterations; // per sample
+	double      nsPerOp;    // median of the samples
+	double      minNsPerOp;
+	double      maxNsPerOp;
+	size_t      bytesPerOp; // data processed by each operation, 0 if not relevant
+	double      allocationsPerOp;
+	double      allocatedBytesPerOp;
+};
+
+// Runs each benchmark for a fixed number of samples. The number of iterations of a sample is calibrated first, so that results
+// don't depend on the resolution of the clock
+class BenchmarkRunner {
+public:
+	explicit BenchmarkRunner(const BenchmarkSettings& settings);
+
+	// Call op repeatedly. bytesPerOp is the size of the data processed by each call, used to report the throughput
+	template <class Op>
+	void run(std::string_view name, size_t bytesPerOp, Op op);
+
+	bool isEnabled(std::string_view name) const;
+	void printResults(FILE* file) const;
+
+private:
+	using SampleFunc = void (*)(void* op, size_t iterations);
+
+	void measure(std::string_view name, size_t bytesPerOp, SampleFunc sample, void* op);
+	void printText(FILE* file) const;
+	void printCSV(FILE* file) const;
+	void printJSON(FILE* file) const;
+
+private:
+	BenchmarkSettings            settings;
+	std::vector<BenchmarkResult> results;
+};
+
+template <class Op>
+void BenchmarkRunner::run(std::string_view name, size_t bytesPerOp, Op op) {
+	if (! isEnabled(name)) {
+		return;
+	}
+	SampleFunc sample = [](void* opPtr, size_t iterations) {
+		Op& op = *static_cast<Op*>(opPtr);
+		for (size_t i = 0; i < iterations; ++i) {
+			op();
+		}
+	};
+	measure(name, bytesPerOp, sample, &op);
+}
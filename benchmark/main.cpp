@@ -0,0 +1,350 @@
+// Benchmarks of the serialization, cloning and lookup hot paths
+// Usage: Benchmark [--filter=name] [--format=text|csv|json] [--samples=count] [--sample-time=ms] [--out=file]
+
+#include "benchmarkClasses.h"
+#include "harness.h"
+#include <reflection/reflection.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace {
+
+// Data sets are generated with fixed seeds, so that runs can be compared
+constexpr unsigned randomSeed = 42;
+constexpr size_t   floatCount = 1 << 20;
+constexpr size_t   pointCount = 1 << 16;
+constexpr size_t   mapSize = 1 << 12;
+constexpr size_t   assetCount = 1 << 12;
+
+WideStruct makeWideStruct() {
+	WideStruct obj;
+	float*     fields = reinterpret_cast<float*>(&obj);
+	static_assert(sizeof obj == 64 * sizeof(float));
+	for (int i = 0; i < 64; ++i) {
+		fields[i] = static_cast<float>(i) * 0.25f;
+	}
+	return obj;
+}
+
+template <int Depth>
+void fillNested(Nested<Depth>& obj) {
+	obj.value = static_cast<float>(Depth);
+	if constexpr (Depth > 0) {
+		obj.name = "level" + std::to_string(Depth);
+		fillNested(obj.child);
+	}
+}
+
+std::vector<float> makeFloats() {
+	std::mt19937                          rng { randomSeed };
+	std::uniform_real_distribution<float> dist { -1000.f, 1000.f };
+	std::vector<float>                    values(floatCount);
+	for (float& v : values) {
+		v = dist(rng);
+	}
+	return values;
+}
+
+std::vector<Point> makePoints() {
+	std::mt19937                          rng { randomSeed };
+	std::uniform_real_distribution<float> dist { -1000.f, 1000.f };
+	std::vector<Point>                    points(pointCount);
+	for (size_t i = 0; i < points.size(); ++i) {
+		points[i] = { dist(rng), dist(rng), dist(rng), static_cast<int>(i) };
+	}
+	return points;
+}
+
+std::map<std::string, int> makeMap() {
+	std::map<std::string, int> map;
+	for (size_t i = 0; i < mapSize; ++i) {
+		map.emplace("key" + std::to_string(i), static_cast<int>(i));
+	}
+	return map;
+}
+
+Assets makeAssets() {
+	std::mt19937_64 rng { randomSeed };
+	Assets          assets;
+	for (size_t i = 0; i < assetCount; ++i) {
+		assets.kinds.push_back(static_cast<AssetKind>(rng() % 64));
+		// Permission masks with a few flags set
+		assets.permissions.push_back(PermissionMask { static_cast<Permission>(1ull << (rng() % 64)) }
+		                             | PermissionMask { static_cast<Permission>(1ull << (rng() % 64)) });
+	}
+	return assets;
+}
+
+std::string makeName(const char* group, const char* operation, const char* dataName) {
+	return std::string { group } + "/" + operation + "/" + dataName;
+}
+
+template <class InputArchiveType>
+bool initializeArchive(InputArchiveType& archive, const std::string& content) {
+	return static_cast<bool>(archive.initialize(content.data()));
+}
+
+#if TY_REFLECTION_BINARY
+bool initializeArchive(refl::BinaryInputArchive& archive, const std::string& content) {
+	return static_cast<bool>(archive.initialize(content.data(), content.size()));
+}
+#endif
+
+template <class OutputArchiveType, class InputArchiveType, class T>
+void benchmarkArchive(BenchmarkRunner& runner, const char* archiveName, const char* dataName, const T& data) {
+	const std::string writeName = makeName(archiveName, "write", dataName);
+	const std::string readName = makeName(archiveName, "read", dataName);
+	if (! runner.isEnabled(writeName) && ! runner.isEnabled(readName)) {
+		return;
+	}
+	std::string content;
+	{
+		OutputArchiveType archive;
+		archive.write("data", data);
+		content = archive.saveToString();
+	}
+	runner.run(writeName, content.size(), [&data] {
+		OutputArchiveType archive;
+		archive.write("data", data);
+		doNotOptimize(archive.saveToString());
+	});
+
+	T readData {};
+	runner.run(readName, content.size(), [&content, &readData] {
+		InputArchiveType archive;
+		if (initializeArchive(archive, content)) {
+			doNotOptimize(archive.read("data", readData));
+		}
+	});
+}
+
+template <class T>
+void benchmarkArchives(BenchmarkRunner& runner, const char* dataName, const T& data) {
+	using namespace refl;
+#if TY_REFLECTION_XML
+	benchmarkArchive<XMLOutputArchive, XMLInputArchive>(runner, "xml", dataName, data);
+#endif
+#if TY_REFLECTION_JSON
+	benchmarkArchive<JSONOutputArchive, JSONInputArchive>(runner, "json", dataName, data);
+	// Same content, read by the streaming archive
+	benchmarkArchive<JSONOutputArchive, JSONStreamInputArchive>(runner, "jsonStream", dataName, data);
+#endif
+#if TY_REFLECTION_BINARY
+	benchmarkArchive<BinaryOutputArchive, BinaryInputArchive>(runner, "binary", dataName, data);
+#endif
+}
+
+#if TY_REFLECTION_JSON
+// Read a document into fresh pmr containers, allocated from the heap or from an arena released after each read
+void benchmarkArenaRead(BenchmarkRunner& runner, const std::map<std::string, int>& map) {
+	using namespace refl;
+	using PmrMap = std::pmr::map<std::pmr::string, int>;
+	PmrMap pmrMap;
+	for (const auto& [key, value] : map) {
+		pmrMap.emplace(key, value);
+	}
+	std::string content;
+	{
+		JSONOutputArchive archive;
+		archive.write("data", pmrMap);
+		content = archive.saveToString();
+	}
+	runner.run("json/read/pmrMap/heap", content.size(), [&content] {
+		JSONInputArchive archive;
+		PmrMap           readData;
+		if (archive.initialize(content.data())) {
+			doNotOptimize(archive.read("data", readData));
+		}
+	});
+
+	Typhoon::PagedAllocator pagedAllocator { getCountingAllocator() };
+	ArenaResource           arena { pagedAllocator, getCountingAllocator() };
+	runner.run("json/read/pmrMap/arena", content.size(), [&content, &arena] {
+		JSONInputArchive archive;
+		archive.setArena(&arena);
+		{
+			PmrMap readData;
+			if (archive.initialize(content.data())) {
+				doNotOptimize(archive.read("data", readData));
+			}
+		}
+		arena.release();
+	});
+}
+#endif
+
+template <class T>
+void benchmarkClone(BenchmarkRunner& runner, const char* dataName, const T& data) {
+	T dst {};
+	runner.run(makeName("clone", "object", dataName), 0, [&data, &dst] { doNotOptimize(refl::cloneObject(&dst, data)); });
+}
+
+void benchmarkVariants(BenchmarkRunner& runner, const Point& point, const WideStruct& wideStruct) {
+	using namespace refl;
+	const Variant number { 3.14, "number" };
+	const Variant string { std::string { "a string longer than the small string buffer" }, "string" };
+	const Variant structure { point, "point" };
+	const Variant wide { wideStruct, "wide" };
+	runner.run("variant/copy/double", 0, [&number] {
+		Variant copy { number };
+		doNotOptimize(copy);
+	});
+	runner.run("variant/copy/string", 0, [&string] {
+		Variant copy { string };
+		doNotOptimize(copy);
+	});
+	runner.run("variant/copy/point", 0, [&structure] {
+		Variant copy { structure };
+		doNotOptimize(copy);
+	});
+	runner.run("variant/copy/wide", 0, [&wide] {
+		Variant copy { wide };
+		doNotOptimize(copy);
+	});
+	const std::vector<Variant> numbers(1024, number);
+	std::vector<Variant>       numberCopies(numbers.size());
+	runner.run("variant/assign/double[1024]", 0, [&numbers, &numberCopies] {
+		std::copy(numbers.begin(), numbers.end(), numberCopies.begin());
+		doNotOptimize(numberCopies);
+	});
+}
+
+template <int... N>
+std::vector<Typhoon::TypeId> getTagTypeIds(std::integer_sequence<int, N...>) {
+	return { Typhoon::getTypeId<Tag<N>>()... };
+}
+
+void benchmarkTypeDB(BenchmarkRunner& runner, const char* suffix) {
+	using namespace refl;
+	const TypeDB&                      typeDB = detail::getTypeDB();
+	const std::vector<Typhoon::TypeId> typeIds = getTagTypeIds(std::make_integer_sequence<int, tagCount> {});
+	std::vector<std::string>           typeNames;
+	for (int i = 0; i < tagCount; ++i) {
+		typeNames.push_back("Tag<" + std::to_string(i) + ">");
+	}
+	size_t i = 0;
+	runner.run(std::string { "typeDB/tryGetType/id" } + suffix, 0, [&] {
+		doNotOptimize(typeDB.tryGetType(typeIds[i]));
+		i = (i + 1) % typeIds.size();
+	});
+	runner.run(std::string { "typeDB/tryGetType/name" } + suffix, 0, [&] {
+		doNotOptimize(typeDB.tryGetType(std::string_view { typeNames[i] }));
+		i = (i + 1) % typeNames.size();
+	});
+}
+
+void benchmarkEnums(BenchmarkRunner& runner) {
+	using namespace refl;
+	const auto& enumType = static_cast<const EnumType&>(getType<AssetKind>());
+	const auto  enumerators = enumType.getEnumerators();
+	size_t      i = 0;
+	runner.run("enum/findByName", 0, [&] {
+		doNotOptimize(enumType.findEnumeratorByName(enumerators[i].name));
+		i = (i + 1) % enumerators.size();
+	});
+	runner.run("enum/findByValue", 0, [&] {
+		doNotOptimize(enumType.findEnumeratorByValue(enumerators[i].value, enumType.getSize()));
+		i = (i + 1) % enumerators.size();
+	});
+}
+
+bool getOptionValue(std::string_view arg, std::string_view option, const char*& value) {
+	if (arg.substr(0, option.size()) == option) {
+		value = arg.data() + option.size();
+		return true;
+	}
+	return false;
+}
+
+bool parseArguments(int argc, char* argv[], BenchmarkSettings& settings, const char*& outFileName) {
+	for (int i = 1; i < argc; ++i) {
+		const char* value = nullptr;
+		if (getOptionValue(argv[i], "--filter=", value)) {
+			settings.filter = value;
+		}
+		else if (getOptionValue(argv[i], "--format=", value) && (! strcmp(value, "text") || ! strcmp(value, "csv") || ! strcmp(value, "json"))) {
+			settings.format = ! strcmp(value, "text") ? OutputFormat::text : (! strcmp(value, "csv") ? OutputFormat::csv : OutputFormat::json);
+		}
+		else if (getOptionValue(argv[i], "--samples=", value)) {
+			settings.sampleCount = std::max(1, std::atoi(value));
+		}
+		else if (getOptionValue(argv[i], "--sample-time=", value)) {
+			settings.sampleTimeMs = std::atof(value);
+		}
+		else if (getOptionValue(argv[i], "--out=", value)) {
+			outFileName = value;
+		}
+		else {
+			std::fprintf(stderr, "Usage: %s [--filter=name] [--format=text|csv|json] [--samples=count] [--sample-time=ms] [--out=file]\n",
+			             argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	BenchmarkSettings settings;
+	const char*       outFileName = nullptr;
+	if (! parseArguments(argc, argv, settings, outFileName)) {
+		return 1;
+	}
+
+	refl::initReflection(getCountingAllocator());
+	registerBenchmarkTypes();
+
+	{
+		BenchmarkRunner runner { settings };
+
+		const WideStruct                 wideStruct = makeWideStruct();
+		Nested<nestingDepth>             nested {};
+		const std::vector<float>         floats = makeFloats();
+		const std::vector<Point>         points = makePoints();
+		const std::map<std::string, int> map = makeMap();
+		const Assets                     assets = makeAssets();
+		fillNested(nested);
+
+		benchmarkArchives(runner, "wide", wideStruct);
+		benchmarkArchives(runner, "nested", nested);
+		benchmarkArchives(runner, "floats", floats);
+		benchmarkArchives(runner, "points", points);
+		benchmarkArchives(runner, "map", map);
+		benchmarkArchives(runner, "assets", assets);
+#if TY_REFLECTION_JSON
+		benchmarkArenaRead(runner, map);
+#endif
+
+		benchmarkClone(runner, "wide", wideStruct);
+		benchmarkClone(runner, "nested", nested);
+		benchmarkClone(runner, "floats", floats);
+		benchmarkClone(runner, "points", points);
+		benchmarkClone(runner, "map", map);
+
+		benchmarkVariants(runner, points.front(), wideStruct);
+		benchmarkEnums(runner);
+		benchmarkTypeDB(runner, "");
+		refl::freezeReflection();
+		benchmarkTypeDB(runner, "/frozen");
+
+		FILE* file = outFileName ? std::fopen(outFileName, "w") : stdout;
+		if (! file) {
+			std::fprintf(stderr, "Cannot open %s\n", outFileName);
+			refl::deinitReflection();
+			return 1;
+		}
+		runner.printResults(file);
+		if (file != stdout) {
+			std::fclose(file);
+		}
+	}
+
+	refl::deinitReflection();
+	return 0;
+}
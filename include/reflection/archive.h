@@ -5,11 +5,23 @@
 #include "writeObject.h"
 #include <core/uncopyable.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
 
 namespace Typhoon::Reflection {
 
+class Executor;
+
+namespace detail {
+
+class ArenaSuspension;
+
+}
+
 class ArchiveIterator {
 public:
 	void* getNode() const {
@@ -63,6 +75,7 @@ enum ValueType {
 	String,
 	True,
 	Undefined,
+	Blob,
 };
 
 class InputArchive : Uncopyable {
@@ -95,6 +108,25 @@ public:
 	virtual bool read(double& value) const = 0;
 	virtual bool read(const char*& str) const = 0;
 	virtual bool read(std::string_view& sv) const = 0;
+	// Strings kept by the objects read, e.g. const char* and std::string_view values. They stay valid as long as the source of the
+	// archive, where read may return strings that are only valid until the next value. Same as read by default
+	virtual bool readStable(const char*& str) const;
+	virtual bool readStable(std::string_view& sv) const;
+	// Raw bytes, for archives that support them. Return false otherwise
+	virtual bool readBlob(std::span<const std::byte>& blob) const;
+	// Parallel reads, for archives that support them. fork returns an archive sharing the data of this one and positioned on child
+	// firstChild of the current array, as if iterateChild(it) had reached it, so that workers can read chunks of the children
+	// concurrently. Return nullptr if there is no such child. The forked archive must not outlive this one
+	virtual bool                          canFork() const;
+	virtual std::unique_ptr<InputArchive> fork(ArchiveIterator& it, size_t firstChild) const;
+	// Bytes of the source consumed so far, for archives that parse it sequentially. Return 0 otherwise
+	virtual size_t getBytesRead() const;
+
+	// Allocate the pmr strings and containers read from this archive from arena, e.g. an ArenaResource. Reading replaces the values of
+	// strings and vectors, so they are rebound to it if they use the default resource, maps only if also empty. The values of pmr
+	// containers that keep another resource are read without the arena. Pass nullptr to keep their own allocators
+	void                       setArena(std::pmr::memory_resource* arena);
+	std::pmr::memory_resource* getArena() const;
 
 	//  Helpers
 	bool read(const char* key, void* data, TypeId typeId) const;
@@ -113,13 +145,44 @@ public:
 	template <class T>
 	T read(const char* key, T&& defaultValue) const;
 
+	// Read a container, deserializing chunks of its values in parallel on executor. The type registry must be frozen, otherwise
+	// or if the archive cannot be forked or has an arena the container is read on the calling thread
+	template <class T>
+	bool read(T& object, Executor& executor) const;
+
+	template <class T>
+	bool read(const char* key, T& object, Executor& executor) const;
+
 private:
 	bool readAny(void* data, const Type& type) const;
 
 private:
-	Context& context;
+	friend class detail::ArenaSuspension;
+	Context&                           context;
+	mutable std::pmr::memory_resource* arena; // suspended while reading the values of containers that keep their own resource
 };
 
+namespace detail {
+
+// Read without the arena of an archive for the lifetime of the object
+class ArenaSuspension : Uncopyable {
+public:
+	explicit ArenaSuspension(const InputArchive& archive)
+	    : archive { archive }
+	    , arena { archive.arena } {
+		archive.arena = nullptr;
+	}
+	~ArenaSuspension() {
+		archive.arena = arena;
+	}
+
+private:
+	const InputArchive&        archive;
+	std::pmr::memory_resource* arena;
+};
+
+} // namespace detail
+
 class OutputArchive : Uncopyable {
 public:
 	OutputArchive();
@@ -141,6 +204,15 @@ public:
 	virtual void        write(double value) = 0;
 	virtual void        write(const char* str) = 0;
 	virtual void        write(std::string_view str) = 0;
+	// Raw bytes, for archives that support them. Return false if nothing was written
+	virtual bool writeBlob(const void* data, size_t size);
+	// Parallel writes, for archives that support them. Chunks of values are written on worker threads into arrays of archives
+	// returned by createChunkArchive, which are then appended in order to the current array with appendChunk
+	virtual bool                           canCreateChunkArchive() const;
+	virtual std::unique_ptr<OutputArchive> createChunkArchive() const;
+	virtual bool                           appendChunk(std::string_view chunk);
+	// Bytes emitted so far, for archives that can tell before saving. Return 0 otherwise
+	virtual size_t getBytesWritten() const;
 
 	// Serialization of attributes
 	virtual void writeAttribute(const char* name, bool value) = 0;
@@ -163,6 +235,14 @@ public:
 	template <class T>
 	void write(const char* key, const T& data);
 
+	// Write a container, serializing chunks of its values in parallel on executor. The type registry must be frozen, otherwise
+	// or if the archive does not support chunks the container is written on the calling thread
+	template <class T>
+	void write(const T& data, Executor& executor);
+
+	template <class T>
+	void write(const char* key, const T& data, Executor& executor);
+
 private:
 	Context& context;
 };
@@ -203,6 +283,28 @@ bool InputArchive::read(T& object) const {
 	return false;
 }
 
+template <class T>
+bool InputArchive::read(const char* key, T& object, Executor& executor) const {
+	bool res = false;
+	if (beginElement(key)) {
+		res = read(object, executor);
+		endElement();
+	}
+	return res;
+}
+
+template <class T>
+bool InputArchive::read(T& object, Executor& executor) const {
+	const Type* type = context.typeDB->tryGetType<T>();
+	if (! type) {
+		type = detail::autoRegisterHelper<T>::autoRegister(context);
+	}
+	if (type) {
+		return detail::readDataParallel(static_cast<void*>(&object), *type, *this, context, executor);
+	}
+	return false;
+}
+
 template <class T>
 void OutputArchive::write(const char* key, const T& data) {
 	setKey(key);
@@ -219,6 +321,22 @@ void OutputArchive::write(const T& data) {
 	detail::writeData(static_cast<const void*>(&data), *type, *this, context);
 }
 
+template <class T>
+void OutputArchive::write(const char* key, const T& data, Executor& executor) {
+	setKey(key);
+	write(data, executor);
+}
+
+template <class T>
+void OutputArchive::write(const T& data, Executor& executor) {
+	const Type* type = context.typeDB->tryGetType<T>();
+	if (! type) {
+		type = detail::autoRegisterHelper<T>::autoRegister(context);
+	}
+	assert(type);
+	detail::writeDataParallel(static_cast<const void*>(&data), *type, *this, context, executor);
+}
+
 class ArrayReadScope : Uncopyable {
 public:
 	ArrayReadScope(InputArchive& archive, const char* key);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <core/allocator.h>
+#include <core/stdAllocator.h>
+#include <core/uncopyable.h>
+
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+namespace Typhoon::Reflection {
+
+// Memory resource over a linear allocator, for the pmr strings and containers read by archives. Deallocation does nothing, the memory
+// of a whole document is discarded at once by rewinding the arena. Blocks the arena cannot serve, e.g. larger than a page, are
+// allocated from the fallback allocator and freed by release
+class ArenaResource final : public std::pmr::memory_resource, Uncopyable {
+public:
+	ArenaResource(LinearAllocator& arena, Allocator& fallbackAllocator);
+	~ArenaResource();
+
+	// Rewind the arena and free the fallback blocks. Objects allocated from this resource must not be used afterwards
+	void release();
+
+	LinearAllocator& getArena() const {
+		return arena;
+	}
+
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override;
+	void  do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+	bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+	struct FallbackBlock {
+		void*  ptr;
+		size_t size;
+	};
+	LinearAllocator&                                        arena;
+	Allocator&                                              fallbackAllocator;
+	std::vector<FallbackBlock, stdAllocator<FallbackBlock>> fallbackBlocks;
+};
+
+namespace detail {
+
+template <class T>
+concept UsesMemoryResource = std::is_same_v<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::value_type>>;
+
+// Rebind an empty pmr string or container that uses the default resource to arena, so that the values read next are allocated from
+// it. Others, e.g. the values of a container with its own resource, keep their resource. Return true if object uses arena
+template <class T>
+bool bindArena(T& object, std::pmr::memory_resource& arena) {
+	if (object.empty() && object.get_allocator().resource() == std::pmr::get_default_resource()) {
+		std::destroy_at(&object);
+		std::construct_at(&object, typename T::allocator_type { &arena });
+	}
+	return object.get_allocator().resource() == &arena;
+}
+
+} // namespace detail
+
+} // namespace Typhoon::Reflection
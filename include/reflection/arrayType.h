@@ -49,6 +49,9 @@ public:
 		assert(false);
 		return nullptr;
 	}
+	void reserve(size_t /*count*/) override {
+		// Fixed size
+	}
 	DataPtr pushBack() override {
 		assert(position < LENGTH);
 		DataPtr value = &container[position];
@@ -79,6 +82,26 @@ public:
 		return allocator.make<WriteIteratorType>(cast<TYPE>(container));
 	}
 
+	bool isContiguous() const override {
+		return true;
+	}
+
+	DataPtr getElementData(DataPtr container) const override {
+		return container;
+	}
+
+	ConstDataPtr getElementData(ConstDataPtr container) const override {
+		return container;
+	}
+
+	size_t getElementCount(ConstDataPtr /*container*/) const override {
+		return LENGTH;
+	}
+
+	bool resize(DataPtr /*container*/, size_t count) const override {
+		return count == LENGTH;
+	}
+
 private:
 	using ReadIteratorType = ArrayReadIterator<TYPE, LENGTH>;
 	using WriteIteratorType = ArrayWriteIterator<TYPE, LENGTH>;
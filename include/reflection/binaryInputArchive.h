@@ -0,0 +1,111 @@
+#pragma once
+
+#include "config.h"
+
+#if TY_REFLECTION_BINARY
+
+#include "archive.h"
+#include "hash.h"
+#include "memoryMappedFile.h"
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Typhoon::Reflection {
+
+// Reads archives written by BinaryOutputArchive
+class BinaryInputArchive final : public InputArchive {
+public:
+	BinaryInputArchive();
+	~BinaryInputArchive();
+
+	// The archive is read in place: data must stay valid while the archive is used. Strings returned by read point into it
+	ParseResult initialize(const void* data, size_t size);
+	// Map the file in memory and read it in place. Nothing is loaded until it is accessed
+	ParseResult initializeFromFile(const char* fileName);
+	bool        beginElement(const char* name) const override;
+	void        endElement() const override;
+	bool        isObject() const override;
+	bool        isArray() const override;
+	ValueType   getValueType() const override;
+	size_t      getElementCount() const override;
+	bool        iterateChild(ArchiveIterator& it) const override;
+	bool        iterateChild(ArchiveIterator& it, const char* name) const override;
+	bool        read(bool& value) const override;
+	bool        read(int& value) const override;
+	bool        read(unsigned int& value) const override;
+	bool        read(int64_t& value) const override;
+	bool        read(uint64_t& value) const override;
+	bool        read(float& value) const override;
+	bool        read(double& value) const override;
+	bool        read(const char*& str) const override;
+	bool        read(std::string_view& sv) const override;
+
+	bool readAttribute(const char* name, bool& value) const override;
+	bool readAttribute(const char* name, int& value) const override;
+	bool readAttribute(const char* name, unsigned int& value) const override;
+	bool readAttribute(const char* name, float& value) const override;
+	bool readAttribute(const char* name, double& value) const override;
+	bool readAttribute(const char* name, const char*& str) const override;
+	bool readAttribute(const char* name, std::string_view& sv) const override;
+
+	// Read bytes written by BinaryOutputArchive::writeBlob. The returned span points into the archive data
+	bool readBlob(std::span<const std::byte>& blob) const override;
+
+	template <class T>
+	bool readSpan(std::span<const T>& span) const;
+
+	// The forked archive reads the data of this one in place
+	bool                          canFork() const override;
+	std::unique_ptr<InputArchive> fork(ArchiveIterator& it, size_t firstChild) const override;
+
+	using InputArchive::read;
+
+private:
+	struct StackItem {
+		const uint8_t* value;
+		const uint8_t* nextMember; // members are usually read in order, so the lookup of the next key starts here
+		uint32_t       nextMemberIndex;
+	};
+
+	bool           beginAttribute(const char* name) const;
+	bool           beginMember(uint32_t keyToken) const;
+	void           pushValue(const uint8_t* value) const;
+	uint32_t       findKeyToken(std::string_view key) const;
+	const uint8_t* readVarint(const uint8_t* ptr, uint64_t& value) const;
+	const uint8_t* skipValue(const uint8_t* value) const;
+	const uint8_t* getBlobData(const uint8_t* value, uint64_t& size) const;
+	template <class T>
+	bool readInteger(T& value) const;
+	template <class T>
+	bool readReal(T& value) const;
+	template <class T>
+	bool readAttributeValue(const char* name, T& value) const;
+
+private:
+	MemoryMappedFile               file;
+	const uint8_t*                 begin;
+	const uint8_t*                 end;
+	const uint8_t*                 root;
+	std::vector<std::string_view>  keys;
+	detail::HashIndex              keyIndex;
+	mutable std::vector<StackItem> stack;
+	mutable std::string            attributeKey; // '@' followed by the attribute name
+};
+
+template <class T>
+bool BinaryInputArchive::readSpan(std::span<const T>& span) const {
+	static_assert(std::is_trivially_copyable_v<T>);
+	std::span<const std::byte> blob;
+	if (readBlob(blob) && blob.size() % sizeof(T) == 0 && reinterpret_cast<uintptr_t>(blob.data()) % alignof(T) == 0) {
+		span = { reinterpret_cast<const T*>(blob.data()), blob.size() / sizeof(T) };
+		return true;
+	}
+	return false;
+}
+
+} // namespace Typhoon::Reflection
+
+#endif
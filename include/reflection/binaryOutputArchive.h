@@ -0,0 +1,97 @@
+#pragma once
+
+#include "config.h"
+
+#if TY_REFLECTION_BINARY
+
+#include "archive.h"
+#include "hash.h"
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Typhoon::Reflection {
+
+// Compact binary archive. Keys are stored once in a table and referenced by index, integers are varints and floats are
+// stored as raw IEEE bytes. See BinaryInputArchive for reading
+class BinaryOutputArchive final : public OutputArchive {
+public:
+	BinaryOutputArchive(bool openRoot = true);
+	~BinaryOutputArchive();
+
+	bool        saveToFile(const char* filename) override;
+	std::string saveToString() override;
+	void        setKey(const char* name) override;
+	bool        beginObject() override;
+	void        endObject() override;
+	bool        beginArray() override;
+	void        endArray() override;
+	void        writeAttribute(const char* name, bool value) override;
+	void        writeAttribute(const char* name, int value) override;
+	void        writeAttribute(const char* name, unsigned int value) override;
+	void        writeAttribute(const char* name, float value) override;
+	void        writeAttribute(const char* name, double value) override;
+	void        writeAttribute(const char* name, const char* str) override;
+	void        write(bool value) override;
+	void        write(int value) override;
+	void        write(unsigned int value) override;
+	void        write(int64_t value) override;
+	void        write(uint64_t value) override;
+	void        write(float value) override;
+	void        write(double value) override;
+	void        write(const char* str) override;
+	void        write(std::string_view str) override;
+
+	// Write raw bytes, aligned so that BinaryInputArchive can return them in place
+	bool writeBlob(const void* data, size_t size) override;
+
+	template <class T>
+	void writeSpan(std::span<const T> span);
+
+	bool                           canCreateChunkArchive() const override;
+	std::unique_ptr<OutputArchive> createChunkArchive() const override;
+	// The keys of the chunk are merged into the key table of this archive. Values are copied as they are if their key tokens do not
+	// change and their blobs stay aligned, and re-encoded otherwise
+	bool appendChunk(std::string_view chunk) override;
+	// Size of the body, without the key table
+	size_t getBytesWritten() const override;
+
+	using OutputArchive::write;
+
+private:
+	void           beginValue(uint8_t tag);
+	void           beginContainer(uint8_t tag);
+	void           endContainer();
+	void           writeVarint(uint64_t value);
+	void           writeKey(std::string_view key);
+	void           writeKeyToken(uint32_t token);
+	void           writeAttributeKey(const char* name);
+	uint32_t       getKeyToken(std::string_view key);
+	const uint8_t* appendValue(const uint8_t* value, const uint8_t* root, const uint8_t* end, const std::vector<uint32_t>& keyTokens);
+
+private:
+	struct Scope {
+		size_t   offset; // offset of the container tag in body
+		uint32_t elementCount;
+		bool     isArray;
+	};
+	std::string              body;
+	std::vector<Scope>       scopes;
+	std::vector<std::string> keys;
+	detail::HashIndex        keyIndex;
+	std::string              attributeKey; // '@' followed by the attribute name
+	bool                     endRoot;
+	bool                     hasBlobs;
+};
+
+template <class T>
+void BinaryOutputArchive::writeSpan(std::span<const T> span) {
+	static_assert(std::is_trivially_copyable_v<T>);
+	writeBlob(span.data(), span.size_bytes());
+}
+
+} // namespace Typhoon::Reflection
+
+#endif
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "hash.h"
 #include "type.h"
 #include <cstdint>
 #include <span>
+#include <string_view>
 
 namespace Typhoon::Reflection {
 
@@ -20,13 +22,15 @@ public:
 
 	std::span<const BitMaskConstant> getEnumerators() const;
 	const char*                      findConstantByValue(BitMaskStorageType value) const;
-	BitMaskStorageType               findConstantByName(const char* enumeratorName) const;
+	// Return 0 if the name is not found
+	BitMaskStorageType               findConstantByName(std::string_view enumeratorName) const;
 	const Type&                      getUnderlyingType() const;
 
 private:
 	const Type*            underlyingType;
 	const BitMaskConstant* enumerators;
 	size_t                 numEnumerators;
+	detail::HashIndex      nameIndex;
 };
 
 } // namespace Typhoon::Reflection
@@ -10,10 +10,20 @@
 #define TY_REFLECTION_JSON 1
 #endif
 
+// Set to 1/0 to enable/disable binary serialization support
+#ifndef TY_REFLECTION_BINARY
+#define TY_REFLECTION_BINARY 1
+#endif
+
 #ifndef TY_REFLECTION_STD
 #define TY_REFLECTION_STD 1
 #endif
 
+// Set to 1 to record per type counters of reads, writes and clones: calls, time, bytes and temporary memory. See TypeDB::getTypeStats
+#ifndef TY_REFLECTION_INSTRUMENTATION
+#define TY_REFLECTION_INSTRUMENTATION 0
+#endif
+
 // Set to 1 to enable the namespace alias "refl" for "Typhoon::Reflection"
 #ifndef TY_REFLECTION_ALIAS_NAMESPACE
 #define TY_REFLECTION_ALIAS_NAMESPACE 1
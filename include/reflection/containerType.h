@@ -3,6 +3,7 @@
 #include "type.h"
 
 #include <memory>
+#include <memory_resource>
 
 namespace Typhoon {
 
@@ -27,6 +28,8 @@ class WriteIterator {
 public:
 	virtual ~WriteIterator() = default;
 
+	// Hint that count values are about to be added. Does nothing by default
+	virtual void    reserve(size_t count);
 	virtual DataPtr pushBack() = 0;
 	virtual DataPtr insert(ConstDataPtr key) = 0;
 	virtual bool    isValid() const = 0;
@@ -48,6 +51,17 @@ public:
 	virtual ReadIterator*  newReadIterator(ConstDataPtr container, ScopedAllocator& allocator) const = 0;
 	virtual WriteIterator* newWriteIterator(DataPtr container, ScopedAllocator& allocator) const = 0;
 
+	// Contiguous containers store their values in a single array, so that values can be accessed and resized in bulk
+	virtual bool         isContiguous() const;
+	virtual DataPtr      getElementData(DataPtr container) const;
+	virtual ConstDataPtr getElementData(ConstDataPtr container) const;
+	virtual size_t       getElementCount(ConstDataPtr container) const;
+	// Return false if the container cannot hold count values, e.g. a fixed size array of a different length
+	virtual bool resize(DataPtr container, size_t count) const;
+	// Containers with a polymorphic allocator that hold no values and use the default resource allocate the values read next from
+	// arena. Return false if the container keeps another resource, in which case its values must not be allocated from arena
+	virtual bool bindArena(DataPtr container, std::pmr::memory_resource& arena) const;
+
 private:
 	const Type* keyType;
 	const Type* valueType;
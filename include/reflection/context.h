@@ -1,5 +1,7 @@
 #pragma once
 
+#include "config.h"
+
 namespace Typhoon {
 
 class Allocator;
@@ -12,11 +14,22 @@ namespace Typhoon::Reflection {
 
 class TypeDB;
 
+#if TY_REFLECTION_INSTRUMENTATION
+namespace detail {
+
+class ScratchTracker;
+
+}
+#endif
+
 struct Context {
 	TypeDB*          typeDB;
 	Allocator*       allocator;
 	LinearAllocator* pagedAllocator;
 	ScopedAllocator* scopedAllocator;
+#if TY_REFLECTION_INSTRUMENTATION
+	detail::ScratchTracker* scratchTracker; // same object as pagedAllocator
+#endif
 };
 
 } // namespace Typhoon::Reflection
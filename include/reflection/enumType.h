@@ -1,10 +1,15 @@
 #pragma once
 
+#include "hash.h"
 #include "type.h"
 
+#include <core/stdAllocator.h>
+
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <span>
+#include <vector>
 
 namespace Typhoon::Reflection {
 
@@ -34,9 +39,29 @@ public:
 	const Type&                 getUnderlyingType() const;
 
 private:
-	const Enumerator* enumerators;
-	size_t            numEnumerators;
-	const Type*       underlyingType;
+	int64_t loadValue(ConstDataPtr value) const;
+	void    buildValueIndex();
+	void    buildNameIndex();
+
+private:
+	friend class TypeDB;
+
+	struct ValueEntry {
+		int64_t  value;
+		uint32_t index;
+	};
+	using IndexVector = std::vector<uint32_t, stdAllocator<uint32_t>>;
+	using ValueVector = std::vector<ValueEntry, stdAllocator<ValueEntry>>;
+
+	const Enumerator*                enumerators;
+	size_t                           numEnumerators;
+	const Type*                      underlyingType;
+	bool                             signedValues;
+	int64_t                          minValue;
+	IndexVector                      denseIndices; // enumerator of each value starting from minValue, if values are contiguous
+	ValueVector                      sortedValues; // sorted by value otherwise
+	detail::HashIndex                nameIndex;
+	mutable detail::PerfectHashTable frozenEnumerators; // built by TypeDB::freeze, replaces nameIndex
 };
 
 } // namespace Typhoon::Reflection
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <core/uncopyable.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace Typhoon::Reflection {
+
+// Runs tasks in parallel, e.g. on top of an existing job system
+class Executor : Uncopyable {
+public:
+	virtual ~Executor() = default;
+
+	// Number of tasks that can run at the same time
+	virtual size_t getConcurrency() const = 0;
+	// Call task for each index in [0, taskCount) and return when all the calls are complete. Tasks can run on any thread
+	virtual void run(size_t taskCount, const std::function<void(size_t)>& task) = 0;
+};
+
+// Runs tasks on threads started by each call to run, and on the calling thread
+class ThreadExecutor final : public Executor {
+public:
+	// 0 uses one thread per hardware thread
+	explicit ThreadExecutor(size_t threadCount = 0);
+
+	size_t getConcurrency() const override;
+	void   run(size_t taskCount, const std::function<void(size_t)>& task) override;
+
+private:
+	size_t threadCount;
+};
+
+} // namespace Typhoon::Reflection
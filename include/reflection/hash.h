@@ -0,0 +1,133 @@
+#pragma once
+
+#include <core/stdAllocator.h>
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Typhoon::Reflection {
+
+/**
+ * @brief 64-bit FNV-1a hash of a string. It can be evaluated at compile time to precompute the hash of constant names
+ */
+constexpr uint64_t hashString(std::string_view str) {
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (char c : str) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+namespace detail {
+
+inline uint64_t hashPointer(const void* ptr) {
+	// Pointers are aligned and close to each other, so mix all the bits (MurmurHash3 finalizer)
+	uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ull;
+	h ^= h >> 33;
+	return h;
+}
+
+// Open addressing hash index with linear probing. It maps 64-bit hashes to 32-bit values, typically indices into an array
+// owned by the caller. Keys are not stored: find() calls a predicate to compare the actual key, so hash collisions are handled
+class HashIndex {
+public:
+	static constexpr uint32_t invalidValue = UINT32_MAX;
+
+	explicit HashIndex(Allocator& allocator);
+
+	void   insert(uint64_t hash, uint32_t value);
+	void   clear();
+	size_t size() const;
+
+	template <class Predicate>
+	uint32_t find(uint64_t hash, Predicate&& predicate) const;
+
+private:
+	void rehash(size_t newCapacity);
+
+private:
+	struct Slot {
+		uint64_t hash;
+		uint32_t value;
+	};
+	std::vector<Slot, stdAllocator<Slot>> slots; // capacity is zero or a power of two
+	size_t                                count;
+};
+
+template <class Predicate>
+inline uint32_t HashIndex::find(uint64_t hash, Predicate&& predicate) const {
+	if (slots.empty()) {
+		return invalidValue;
+	}
+	const size_t mask = slots.size() - 1;
+	// The load factor is kept below 1/2, so the probe sequence always reaches an empty slot
+	for (size_t i = hash & mask;; i = (i + 1) & mask) {
+		const Slot& slot = slots[i];
+		if (slot.value == invalidValue) {
+			return invalidValue;
+		}
+		if (slot.hash == hash && predicate(slot.value)) {
+			return slot.value;
+		}
+	}
+}
+
+// Read-only perfect hash table built with the hash and displace method: each bucket stores the seed that sends all of its hashes
+// to distinct slots, so a lookup is two memory reads and a comparison, without probing. Hashes must be unique
+class PerfectHashTable {
+public:
+	static constexpr uint32_t invalidValue = UINT32_MAX;
+
+	struct Entry {
+		uint64_t hash;
+		uint32_t value;
+	};
+
+	static size_t getStorageSize(size_t entryCount);
+
+	// storage must hold getStorageSize(entries.size()) bytes, aligned to alignof(Entry). Return false if the table could not be built
+	bool build(std::span<const Entry> entries, void* storage, Allocator& tempAllocator);
+	bool isValid() const;
+
+	uint32_t find(uint64_t hash) const;
+
+private:
+	static size_t getSlotIndex(uint64_t hash, uint32_t seed, size_t slotMask);
+
+private:
+	const Entry*    slots = nullptr;
+	const uint32_t* seeds = nullptr;
+	size_t          slotMask = 0;
+	size_t          bucketMask = 0;
+};
+
+inline bool PerfectHashTable::isValid() const {
+	return slots != nullptr;
+}
+
+inline size_t PerfectHashTable::getSlotIndex(uint64_t hash, uint32_t seed, size_t slotMask) {
+	uint64_t h = hash ^ (seed * 0x9e3779b97f4a7c15ull);
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	return static_cast<size_t>(h) & slotMask;
+}
+
+inline uint32_t PerfectHashTable::find(uint64_t hash) const {
+	assert(isValid());
+	const uint32_t seed = seeds[(hash >> 32) & bucketMask];
+	const Entry&   entry = slots[getSlotIndex(hash, seed, slotMask)];
+	return entry.hash == hash ? entry.value : invalidValue;
+}
+
+} // namespace detail
+
+} // namespace Typhoon::Reflection
@@ -43,6 +43,10 @@ public:
 	bool readAttribute(const char* name, const char*& str) const override;
 	bool readAttribute(const char* name, std::string_view& sv) const override;
 
+	// The forked archive reads the document of this one
+	bool                          canFork() const override;
+	std::unique_ptr<InputArchive> fork(ArchiveIterator& it, size_t firstChild) const override;
+
 	using InputArchive::read;
 
 private:
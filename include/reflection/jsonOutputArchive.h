@@ -7,15 +7,31 @@
 #include "../external/rapidjson/include/rapidjson/fwd.h"
 #include "../external/rapidjson/include/rapidjson/prettywriter.h"
 #include "archive.h"
+#include <cstdio>
 #include <memory>
+#include <variant>
 
 namespace Typhoon::Reflection {
 
+enum class JSONFormat {
+	pretty,
+	compact, // no indentation nor new lines
+};
+
 class JSONOutputArchive final : public OutputArchive {
 public:
-	JSONOutputArchive(bool openRoot=true);
+	JSONOutputArchive(bool openRoot = true, JSONFormat format = JSONFormat::pretty);
+	// Write straight to a file through a fixed size buffer, so that memory usage does not depend on the size of the archive.
+	// saveToFile and saveToString are not available, call closeFile or destroy the archive to complete the file
+	JSONOutputArchive(const char* fileName, bool openRoot = true, JSONFormat format = JSONFormat::pretty);
 	~JSONOutputArchive();
 
+	bool isFileOpen() const;
+	// Return false if the file could not be opened. The output is then discarded
+	bool isValid() const;
+	// Flush and close the file. Return false if the file could not be opened or written
+	bool closeFile();
+
 	bool        saveToFile(const char* filename) override;
 	std::string saveToString() override;
 	void        setKey(const char* name) override;
@@ -39,15 +55,41 @@ public:
 	void        write(const char* str) override;
 	void        write(std::string_view str) override;
 
+	// Chunks are compact whatever the format of the archive
+	bool                           canCreateChunkArchive() const override;
+	std::unique_ptr<OutputArchive> createChunkArchive() const override;
+	bool                           appendChunk(std::string_view chunk) override;
+	// Return 0 when writing to a file
+	size_t getBytesWritten() const override;
+
 	using OutputArchive::write;
 
 private:
-	void writeAttributeKey(const char* key) const;
+	// Output stream that discards everything, used when the file could not be opened
+	struct NullStream {
+		using Ch = char;
+		void Put(Ch) {
+		}
+		void Flush() {
+		}
+	};
+	using Writer = std::variant<rapidjson::PrettyWriter<rapidjson::StringBuffer>, rapidjson::Writer<rapidjson::StringBuffer>,
+	                            rapidjson::PrettyWriter<rapidjson::FileWriteStream>, rapidjson::Writer<rapidjson::FileWriteStream>,
+	                            rapidjson::Writer<NullStream>>;
+
+	template <class Function>
+	decltype(auto) visitWriter(Function&& function);
+	void           writeAttributeKey(const char* key);
+	void           endRootObject();
 
 private:
-	std::unique_ptr<rapidjson::StringBuffer>                          stream;
-	std::unique_ptr<rapidjson::PrettyWriter<rapidjson::StringBuffer>> writer;
-	bool                                                              endRoot;
+	std::unique_ptr<rapidjson::StringBuffer>    stream;
+	std::FILE*                                  file;
+	std::unique_ptr<char[]>                     fileBuffer;
+	std::unique_ptr<rapidjson::FileWriteStream> fileStream;
+	std::unique_ptr<NullStream>                 nullStream;
+	std::unique_ptr<Writer>                     writer;
+	bool                                        endRoot;
 };
 
 } // namespace Typhoon::Reflection
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "config.h"
+
+#if TY_REFLECTION_JSON
+
+#include "archive.h"
+#include <memory>
+
+namespace Typhoon::Reflection {
+
+// JSON input archive that parses the text while objects are read, without building a document first. Members read in the
+// order they were written are parsed straight into the objects. Members skipped while looking for another key are buffered,
+// so they can still be read later
+class JSONStreamInputArchive final : public InputArchive {
+public:
+	JSONStreamInputArchive();
+	~JSONStreamInputArchive();
+
+	// buffer must be null terminated and stay valid while the archive is used
+	ParseResult initialize(const char* buffer);
+	// The file is read in chunks as parsing proceeds
+	ParseResult initializeFromFile(const char* fileName);
+	// Parse errors are only found when the invalid text is reached. Return the first one
+	ParseResult getParseResult() const;
+	bool        beginElement(const char* name) const override;
+	void        endElement() const override;
+	bool        isObject() const override;
+	bool        isArray() const override;
+	ValueType   getValueType() const override;
+	// Return 0 for objects and arrays that are still being parsed, as their size is not known
+	size_t      getElementCount() const override;
+	bool        iterateChild(ArchiveIterator& it) const override;
+	bool        iterateChild(ArchiveIterator& it, const char* name) const override;
+	bool        read(bool& value) const override;
+	bool        read(int& value) const override;
+	bool        read(unsigned int& value) const override;
+	bool        read(int64_t& value) const override;
+	bool        read(uint64_t& value) const override;
+	bool        read(float& value) const override;
+	bool        read(double& value) const override;
+	// Strings are not copied. They stay valid until the next value is parsed, so read them before reading other values
+	bool        read(const char*& str) const override;
+	bool        read(std::string_view& sv) const override;
+	// Strings are copied, and stay valid until the archive is destroyed or initialized again
+	bool        readStable(const char*& str) const override;
+	bool        readStable(std::string_view& sv) const override;
+	size_t      getBytesRead() const override;
+
+	bool readAttribute(const char* name, bool& value) const override;
+	bool readAttribute(const char* name, int& value) const override;
+	bool readAttribute(const char* name, unsigned int& value) const override;
+	bool readAttribute(const char* name, float& value) const override;
+	bool readAttribute(const char* name, double& value) const override;
+	bool readAttribute(const char* name, const char*& str) const override;
+	bool readAttribute(const char* name, std::string_view& sv) const override;
+
+	using InputArchive::read;
+
+private:
+	template <class T>
+	bool readAttributeValue(const char* name, T& value) const;
+
+private:
+	struct Parser;
+	std::unique_ptr<Parser> parser;
+};
+
+} // namespace Typhoon::Reflection
+
+#endif
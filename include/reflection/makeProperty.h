@@ -2,74 +2,143 @@
 
 #include "property.h"
 #include "typeDB.h"
+#include <bit>
 #include <cassert>
+#include <core/scopedAllocator.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace Typhoon::Reflection::detail {
 
+// Placeholder for the missing accessor of read-only and write-only properties
+struct NoAccessor {};
+
+// Setter and getter wrapped by a property, stored in its context
+template <class S, class G>
+struct Accessors {
+	[[no_unique_address]] S setter;
+	[[no_unique_address]] G getter;
+};
+
 template <typename C>
 class ClassUtil {
 private:
 	template <typename T>
-	static Getter wrapGetter(T C::*memberPtr) {
-		return [memberPtr](ConstDataPtr self, DataPtr temporary) {
-			if constexpr (std::is_array_v<T>) {
-				// Arrays are not assignable in C++
-				auto& dst = deref<T>(temporary);
-				auto& src = (cast<C>(self)->*memberPtr);
-				std::copy(std::begin(src), std::end(src), std::begin(dst));
-			}
-			else {
-				deref<T>(temporary) = (cast<C>(self)->*memberPtr);
-			}
-			return temporary;
-		};
+	static ConstDataPtr callGetter(T C::*memberPtr, ConstDataPtr self, DataPtr temporary) {
+		if constexpr (std::is_array_v<T>) {
+			// Arrays are not assignable in C++
+			auto& dst = deref<T>(temporary);
+			auto& src = (cast<C>(self)->*memberPtr);
+			std::copy(std::begin(src), std::end(src), std::begin(dst));
+		}
+		else {
+			deref<T>(temporary) = (cast<C>(self)->*memberPtr);
+		}
+		return temporary;
 	}
 
 	template <typename T>
-	static Setter wrapSetter(T C::*memberPtr) {
-		return [memberPtr](DataPtr self, ConstDataPtr value) {
-			if constexpr (std::is_array_v<T>) {
-				// Arrays are not assignable in C++
-				auto& src = deref<T>(value);
-				auto& dst = (cast<C>(self)->*memberPtr);
-				std::copy(std::begin(src), std::end(src), std::begin(dst));
-			}
-			else {
-				(cast<C>(self)->*memberPtr) = deref<T>(value);
-			}
-		};
+	static void callSetter(T C::*memberPtr, DataPtr self, ConstDataPtr value) {
+		if constexpr (std::is_array_v<T>) {
+			// Arrays are not assignable in C++
+			auto& src = deref<T>(value);
+			auto& dst = (cast<C>(self)->*memberPtr);
+			std::copy(std::begin(src), std::end(src), std::begin(dst));
+		}
+		else {
+			(cast<C>(self)->*memberPtr) = deref<T>(value);
+		}
 	}
+
 	template <class R>
-	static Getter wrapGetter(R (C::*func)() const) {
+	static ConstDataPtr callGetter(R (C::*func)() const, ConstDataPtr self, DataPtr temporary) {
 		using T = std::decay_t<R>;
-		return [func](ConstDataPtr self, DataPtr temporary) {
-			deref<T>(temporary) = (cast<C>(self)->*func)();
-			return temporary;
-		};
+		deref<T>(temporary) = (cast<C>(self)->*func)();
+		return temporary;
 	}
 
 	template <typename A>
-	static Setter wrapSetter(void (C::*func)(A)) {
+	static void callSetter(void (C::*func)(A), DataPtr self, ConstDataPtr value) {
 		using T = std::decay_t<A>;
-		return [func](DataPtr self, ConstDataPtr value) { //
-			(cast<C>(self)->*func)(deref<T>(value));
-		};
+		(cast<C>(self)->*func)(deref<T>(value));
 	}
 
 	template <typename R>
-	static Getter wrapGetter(R (*func)(const C&)) {
+	static ConstDataPtr callGetter(R (*func)(const C&), ConstDataPtr self, DataPtr temporary) {
 		using T = std::decay_t<R>;
-		return [func](ConstDataPtr self, DataPtr temporary) {
-			// TODO don't always build temporary
-			deref<T>(temporary) = func(deref<C>(self));
-			return temporary;
-		};
+		// TODO don't always build temporary
+		deref<T>(temporary) = func(deref<C>(self));
+		return temporary;
 	}
 
 	template <typename A>
-	static Setter wrapSetter(void (*func)(C&, A)) {
+	static void callSetter(void (*func)(C&, A), DataPtr self, ConstDataPtr value) {
 		using T = std::decay_t<A>;
-		return [func](DataPtr self, ConstDataPtr value) { func(deref<C>(self), deref<T>(value)); };
+		func(deref<C>(self), deref<T>(value));
+	}
+
+	// Accessors that do not fit in the property context are allocated in the arena, the context stores a pointer to them
+	template <class AccessorPair>
+	static constexpr bool isInline = sizeof(AccessorPair) <= Property::contextSize && alignof(AccessorPair) <= alignof(void*);
+
+	template <class AccessorPair>
+	static const AccessorPair& getAccessors(const void* context) {
+		if constexpr (isInline<AccessorPair>) {
+			return *static_cast<const AccessorPair*>(context);
+		}
+		else {
+			return **static_cast<const AccessorPair* const*>(context);
+		}
+	}
+
+	template <class AccessorPair>
+	static ConstDataPtr getValue(const void* context, ConstDataPtr self, DataPtr temporary) {
+		return callGetter(getAccessors<AccessorPair>(context).getter, self, temporary);
+	}
+
+	template <class AccessorPair>
+	static void setValue(const void* context, DataPtr self, ConstDataPtr value) {
+		callSetter(getAccessors<AccessorPair>(context).setter, self, value);
+	}
+
+	template <class S, class G>
+	static Property makeAccessorProperty(const char* name, S setter, G getter, const Type* valueType, Context& context,
+	                                     size_t fieldOffset = Property::noFieldOffset) {
+		using AccessorPair = Accessors<S, G>;
+		static_assert(std::is_trivially_copyable_v<AccessorPair>);
+		Setter setterFunc = nullptr;
+		Getter getterFunc = nullptr;
+		if constexpr (! std::is_same_v<S, NoAccessor>) {
+			setterFunc = &setValue<AccessorPair>;
+		}
+		if constexpr (! std::is_same_v<G, NoAccessor>) {
+			getterFunc = &getValue<AccessorPair>;
+		}
+		const AccessorPair accessors { setter, getter };
+		if constexpr (isInline<AccessorPair>) {
+			return { setterFunc, getterFunc, &accessors, sizeof(accessors), name, valueType, *context.scopedAllocator, fieldOffset };
+		}
+		else {
+			const AccessorPair* external = context.scopedAllocator->make<AccessorPair>(accessors);
+			return { setterFunc, getterFunc, &external, sizeof(external), name, valueType, *context.scopedAllocator, fieldOffset };
+		}
+	}
+
+	template <typename T>
+	static size_t getFieldOffset(T C::*memberPtr) {
+		if constexpr (std::is_array_v<T> || ! std::is_standard_layout_v<C>) {
+			// Arrays are not assignable, and other classes may have virtual bases. Keep copying their fields through the getter and
+			// setter
+			return Property::noFieldOffset;
+		}
+		else {
+			// offsetof does not accept member pointers. Without virtual bases, the supported ABIs store the offset of the member in the
+			// member pointer, so no object is needed
+			using Offset = std::conditional_t<sizeof(memberPtr) == sizeof(int32_t), int32_t, std::ptrdiff_t>;
+			static_assert(sizeof(Offset) == sizeof(memberPtr), "Unsupported member pointer representation");
+			return static_cast<size_t>(std::bit_cast<Offset>(memberPtr));
+		}
 	}
 
 public:
@@ -78,21 +147,21 @@ public:
 		static_assert(std::is_same_v<std::decay_t<R>, std::decay_t<A>>);
 		using ValueType = std::decay_t<R>;
 		const Type* valueType = autoRegisterType<ValueType>(context);
-		return { wrapSetter(setter), wrapGetter(getter), name, valueType, *context.allocator };
+		return makeAccessorProperty(name, setter, getter, valueType, context);
 	}
 
 	template <typename A>
 	static Property makeProperty(const char* name, void (*setter)(C&, A), Context& context) {
 		using ValueType = std::decay_t<A>;
 		const Type* type = autoRegisterType<ValueType>(context);
-		return { wrapSetter(setter), nullptr, name, type, *context.allocator };
+		return makeAccessorProperty(name, setter, NoAccessor {}, type, context);
 	}
 
 	template <typename T, typename A>
 	static Property makeProperty(const char* name, void (*setter)(C&, A), T C::*memberPtr, Context& context) {
 		static_assert(std::is_same_v<T, std::decay_t<A>>);
 		const Type* varType = autoRegisterType<T>(context);
-		return { wrapSetter(setter), wrapGetter(memberPtr), name, varType, *context.allocator };
+		return makeAccessorProperty(name, setter, memberPtr, varType, context);
 	}
 
 	template <typename R, typename A>
@@ -100,7 +169,7 @@ public:
 		static_assert(std::is_same_v<std::decay_t<R>, std::decay_t<A>>);
 		using ValueType = std::decay_t<R>;
 		const Type* valueType = autoRegisterType<ValueType>(context);
-		return { wrapSetter(setter), wrapGetter(getter), name, valueType, *context.allocator };
+		return makeAccessorProperty(name, setter, getter, valueType, context);
 	}
 
 	template <typename R>
@@ -108,27 +177,27 @@ public:
 		using ValueType = std::decay_t<R>;
 		const Type* A = autoRegisterType<ValueType>(context);
 		assert(A);
-		return { nullptr, wrapGetter(getter), name, A, *context.allocator };
+		return makeAccessorProperty(name, NoAccessor {}, getter, A, context);
 	}
 
 	template <typename R>
 	static Property makeProperty(const char* name, R (C::*getter)() const, Context& context) {
 		using ValueType = std::decay_t<R>;
 		const Type* valueType = autoRegisterType<ValueType>(context);
-		return { nullptr, wrapGetter(getter), name, valueType, *context.allocator };
+		return makeAccessorProperty(name, NoAccessor {}, getter, valueType, context);
 	}
 
 	template <typename A>
 	static Property makeProperty(const char* name, void (C::*setter)(A), Context& context) {
 		using ValueType = std::decay_t<A>;
 		const Type* valueType = autoRegisterType<ValueType>(context);
-		return { wrapSetter(setter), nullptr, name, valueType, *context.allocator };
+		return makeAccessorProperty(name, setter, NoAccessor {}, valueType, context);
 	}
 
 	template <typename T>
 	static Property makeProperty(const char* name, T C::*memberPtr, Context& context) {
 		const Type* varType = autoRegisterType<T>(context);
-		return { wrapSetter(memberPtr), wrapGetter(memberPtr), name, varType, *context.allocator };
+		return makeAccessorProperty(name, memberPtr, memberPtr, varType, context, getFieldOffset(memberPtr));
 	}
 };
 
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <core/uncopyable.h>
+
+#include <cstddef>
+
+namespace Typhoon::Reflection {
+
+// Read-only view of a whole file mapped in memory. Pages are loaded by the OS on first access
+class MemoryMappedFile : Uncopyable {
+public:
+	MemoryMappedFile();
+	~MemoryMappedFile();
+
+	bool        open(const char* fileName);
+	void        close();
+	bool        isOpen() const;
+	const void* getData() const;
+	size_t      getSize() const;
+
+private:
+	const void* data;
+	size_t      size;
+};
+
+} // namespace Typhoon::Reflection
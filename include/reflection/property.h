@@ -4,28 +4,42 @@
 #include "config.h"
 #include "dataPtr.h"
 #include "semantics.h"
-#include <core/stdAllocator.h>
 
+#include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <span>
-#include <vector>
+
+namespace Typhoon {
+
+class LinearAllocator;
+class ScopedAllocator;
+
+} // namespace Typhoon
 
 namespace Typhoon::Reflection {
 
 class Type;
 
-using Getter = std::function<ConstDataPtr(ConstDataPtr self, DataPtr temporary)>;
-using Setter = std::function<void(DataPtr self, ConstDataPtr value)>; // TODO DataPtr value to allow move?
+// Accessors are plain functions. The context points to the data bound to the property, e.g. the wrapped member pointer
+using Getter = ConstDataPtr (*)(const void* context, ConstDataPtr self, DataPtr temporary);
+using Setter = void (*)(const void* context, DataPtr self, ConstDataPtr value); // TODO DataPtr value to allow move?
 
 class Property {
 public:
-	Property(Setter&& setter, Getter&& getter, const char* name, const Type* valueType, Allocator& allocator);
+	static constexpr size_t noFieldOffset = SIZE_MAX;
+	// Size of the context stored inline. Larger contexts must be allocated by the caller, storing a pointer to them
+	static constexpr size_t contextSize = 2 * sizeof(void*);
+
+	// The context is copied into the property. Attributes are allocated in the arena
+	Property(Setter setter, Getter getter, const void* context, size_t contextSize, const char* name, const Type* valueType, ScopedAllocator& arena,
+	         size_t fieldOffset = noFieldOffset);
 	const char*                       getName() const;
 	const char*                       getPrettyName() const;
 	const Type&                       getValueType() const;
 	uint32_t                          getFlags() const;
 	Semantic                          getSemantic() const;
+	bool                              isField() const;
+	size_t                            getFieldOffset() const;
 	Property&                         setPrettyName(const char* str);
 	Property&                         setFlags(uint32_t flags);
 	Property&                         setSemantic(Semantic semantic);
@@ -39,21 +53,27 @@ public:
 	const Attribute* queryAttribute() const;
 
 private:
-	using AttributeVec = std::vector<const Attribute*, stdAllocator<const Attribute*>>;
+	static constexpr uint32_t noFieldOffset32 = UINT32_MAX;
 
-	Setter       setter;
-	Getter       getter;
-	const char*  name;
-	const char*  prettyName;
-	const Type*  valueType;
-	uint32_t     flags;
-	Semantic     semantic;
-	AttributeVec attributes;
+	// Members used while objects are serialized come first, filling one cache line
+	Getter                  getter;
+	Setter                  setter;
+	const Type*             valueType;
+	const char*             name;
+	uint32_t                fieldOffset; // offset of a plain data member, accessible in place
+	uint32_t                flags;
+	Semantic                semantic;
+	uint32_t                attributeCount;
+	alignas(void*) char     context[contextSize];
+	// Metadata
+	const char*             prettyName;
+	const Attribute* const* attributes;
+	ScopedAllocator*        arena;
 };
 
 template <class T>
 const Attribute* Property::queryAttribute() const {
-	for (auto a : attributes) {
+	for (auto a : getAttributes()) {
 		if (a->tryCast<T>()) {
 			return a;
 		}
@@ -14,6 +14,7 @@
 
 namespace Typhoon::Reflection {
 
+class Executor;
 class InputArchive;
 
 namespace detail {
@@ -21,6 +22,7 @@ namespace detail {
 TypeDB&  getTypeDB();
 Context& getContext();
 bool     readData(DataPtr object, const Type& type, const InputArchive& archive, const Context& context, Semantic semantic = Semantic::none);
+bool     readDataParallel(DataPtr object, const Type& type, const InputArchive& archive, const Context& context, Executor& executor);
 
 } // namespace detail
 
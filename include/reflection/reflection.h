@@ -2,10 +2,12 @@
 
 #include "config.h"
 
+#include "arenaResource.h"
 #include "bitMaskType.h"
 #include "builtinType.h"
 #include "cloneObject.h"
 #include "containerType.h"
+#include "executor.h"
 #include "namespace.h"
 #include "pointerType.h"
 #include "readObject.h"
@@ -25,6 +27,12 @@
 #ifdef TY_REFLECTION_JSON
 #include "jsonInputArchive.h"
 #include "jsonOutputArchive.h"
+#include "jsonStreamInputArchive.h"
+#endif
+
+#ifdef TY_REFLECTION_BINARY
+#include "binaryInputArchive.h"
+#include "binaryOutputArchive.h"
 #endif
 
 namespace Typhoon {
@@ -57,6 +65,35 @@ bool isInitialized();
  */
 void deinitReflection();
 
+/**
+ * @brief Make the type registry read-only and build perfect hash tables for type, property and enumerator lookups.
+ * Call it after all types have been registered: further registrations are rejected
+ * @return false if some tables could not be built; their lookups keep working, without perfect hashing
+ */
+bool freezeReflection();
+
+/**
+ * @brief Create a context for the calling thread, so that it can read, write and clone objects concurrently with other threads.
+ * The thread shares the type registry, which must be frozen, and gets its own allocator for temporaries and archive data
+ */
+void initThreadContext();
+
+/**
+ * @brief Create a context for the calling thread with a custom allocator
+ * @param allocator custom allocator, only used by the calling thread
+ */
+void initThreadContext(Allocator& allocator);
+
+/**
+ * @brief Destroy the context of the calling thread. Archives created on the thread must be destroyed first
+ */
+void deinitThreadContext();
+
+/**
+ * @brief Return true if initThreadContext has been called on the calling thread
+ */
+bool hasThreadContext();
+
 /**
  * @brief
  * @param typeID
@@ -134,16 +134,16 @@ Context& getContext();
 		structType->setCustomCloner(cloner); \
 	} while (0)
 
-#define END_STRUCT()                    \
-	typeDB_.registerType(structType);   \
-	currNamespace->addType(structType); \
-	}                                   \
+#define END_STRUCT()                                         \
+	refl::detail::registerRequiredType(typeDB_, structType); \
+	currNamespace->addType(structType);                      \
+	}                                                        \
 	while (0)
 
-#define END_CLASS()                     \
-	typeDB_.registerType(structType);   \
-	currNamespace->addType(structType); \
-	}                                   \
+#define END_CLASS()                                          \
+	refl::detail::registerRequiredType(typeDB_, structType); \
+	currNamespace->addType(structType);                      \
+	}                                                        \
 	while (0)
 
 #define BEGIN_ENUM(enumClass)                                    \
@@ -164,7 +164,7 @@ Context& getContext();
 	const Type& underlyingType = typeDB_.getType<std::underlying_type_t<enumClass_>>();                                                         \
 	const auto  enumType = scopedAllocator_.make<EnumType>(enumName, Typhoon::getTypeId<enumClass_>(), sizeof(enumClass_), alignof(enumClass_), \
                                                           enumerators, std::size(enumerators), &underlyingType, allocator_);                   \
-	typeDB_.registerType(enumType);                                                                                                             \
+	refl::detail::registerRequiredType(typeDB_, enumType);                                                                                      \
 	currNamespace->addType(enumType);                                                                                                           \
 	}                                                                                                                                           \
 	while (false)
@@ -183,7 +183,7 @@ Context& getContext();
 	const Type& underlyingType = typeDB_.getType<bitMaskStruct_::ValueType>();                                                                     \
 	const auto  bitmaskType =                                                                                                                        \
 	    scopedAllocator_.make<BitMaskType>(typeName, getTypeId<bitMaskStruct_>(), &underlyingType, enumerators, std::size(enumerators), allocator_); \
-	typeDB_.registerType(bitmaskType);                                                                                                               \
+	refl::detail::registerRequiredType(typeDB_, bitmaskType);                                                                                        \
 	currNamespace->addType(bitmaskType);                                                                                                             \
 	}                                                                                                                                                \
 	while (false)
@@ -1,3 +1,9 @@
+#pragma once
+
+#include <core/typeId.h>
+
+#include <cstddef>
+
 namespace Typhoon::Reflection {
 
 class InputArchive;
@@ -33,4 +39,14 @@ void write(float data, OutputArchive& archive);
 void write(double data, OutputArchive& archive);
 void write(const char* str, OutputArchive& archive);
 
+namespace detail {
+
+// Arrays of numbers are serialized in a single loop, without dispatching on the type of each value
+bool isNumberType(TypeId typeId);
+bool writeNumbers(const void* values, size_t count, TypeId typeId, OutputArchive& archive);
+// Read the children of the current element into count values
+bool readNumbers(void* values, size_t count, TypeId typeId, const InputArchive& archive);
+
+} // namespace detail
+
 } // namespace Typhoon::Reflection
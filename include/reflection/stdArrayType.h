@@ -52,6 +52,9 @@ public:
 		(void)key;
 		return nullptr;
 	}
+	void reserve(size_t /*count*/) override {
+		// Fixed size
+	}
 	DataPtr pushBack() override {
 		assert(position < L);
 		++position;
@@ -83,6 +86,26 @@ public:
 		return allocator.make<WriteIteratorType>(cast<T>(container));
 	}
 
+	bool isContiguous() const override {
+		return true;
+	}
+
+	DataPtr getElementData(DataPtr container) const override {
+		return container;
+	}
+
+	ConstDataPtr getElementData(ConstDataPtr container) const override {
+		return container;
+	}
+
+	size_t getElementCount(ConstDataPtr /*container*/) const override {
+		return L;
+	}
+
+	bool resize(DataPtr /*container*/, size_t count) const override {
+		return count == L;
+	}
+
 private:
 	using ReadIteratorType = StdArrayReadIterator<T, L>;
 	using WriteIteratorType = StdArrayWriteIterator<T, L>;
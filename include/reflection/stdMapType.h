@@ -1,5 +1,6 @@
 #pragma once
 
+#include "arenaResource.h"
 #include "containerType.h"
 #include "context.h"
 #include "typeDB.h"
@@ -47,6 +48,13 @@ public:
 	    , iter(container->begin()) {
 	}
 
+	void reserve([[maybe_unused]] size_t count) override {
+		// Only hashed maps can preallocate
+		if constexpr (requires { container->reserve(count); }) {
+			container->reserve(container->size() + count);
+		}
+	}
+
 	DataPtr pushBack() override {
 		assert(0);
 		return nullptr;
@@ -86,6 +94,13 @@ public:
 		return allocator.make<WriteIteratorType>(cast<MAP_TYPE>(container));
 	}
 
+	bool bindArena([[maybe_unused]] DataPtr container, [[maybe_unused]] std::pmr::memory_resource& arena) const override {
+		if constexpr (UsesMemoryResource<MAP_TYPE>) {
+			return detail::bindArena(*cast<MAP_TYPE>(container), arena);
+		}
+		return true;
+	}
+
 private:
 	using ReadIteratorType = StdMapReadIterator<MAP_TYPE>;
 	using WriteIteratorType = StdMapWriteIterator<MAP_TYPE>;
@@ -109,4 +124,20 @@ struct autoRegisterHelper<std::map<_Kty, T>> {
 	}
 };
 
+// std::pmr::map specialization
+template <class _Kty, class T>
+struct autoRegisterHelper<std::pmr::map<_Kty, T>> {
+	static const Type* autoRegister(Context& context) {
+		using KeyType = _Kty;
+		using MappedType = T;
+		using ContainerType = std::pmr::map<_Kty, T>;
+		const Type*      keyType = autoRegisterType<KeyType>(context);
+		const Type*      mappedType = autoRegisterType<MappedType>(context);
+		constexpr TypeId typeID = getTypeId<ContainerType>();
+		const char*      innerTypeNames[] = { keyType->getName(), mappedType->getName(), nullptr };
+		const char*      typeName = buildTemplateTypeName(innerTypeNames, "std::pmr::map<", ">", *context.scopedAllocator);
+		return context.scopedAllocator->make<StdMapContainer<ContainerType>>(typeName, typeID, keyType, mappedType, *context.allocator);
+	}
+};
+
 } // namespace Typhoon::Reflection::detail
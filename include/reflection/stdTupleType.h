@@ -16,18 +16,18 @@ Property tupleElementProperty(const char* name, Context& context) {
 	using E = std::tuple_element_t<index, C>;
 	const Type* varType = autoRegisterType<E>(context);
 
-	auto getter = [](ConstDataPtr self, DataPtr temporary) {
+	Getter getter = [](const void* /*context*/, ConstDataPtr self, DataPtr temporary) -> ConstDataPtr {
 		const C* tuple = cast<C>(self);
 		*cast<E>(temporary) = std::get<index>(*tuple);
 		return temporary;
 	};
 
-	auto setter = [](DataPtr self, ConstDataPtr value) {
+	Setter setter = [](const void* /*context*/, DataPtr self, ConstDataPtr value) {
 		C* tuple = cast<C>(self);
 		std::get<index>(*tuple) = *cast<E>(value);
 	};
 
-	return { setter, getter, name, varType, *context.allocator };
+	return { setter, getter, nullptr, 0, name, varType, *context.scopedAllocator };
 }
 
 template <typename Tuple, size_t ElementIndex>
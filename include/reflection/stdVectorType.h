@@ -1,11 +1,13 @@
 #pragma once
 
+#include "arenaResource.h"
 #include "containerType.h"
 #include "context.h"
 #include "typeDB.h"
 #include <core/scopedAllocator.h>
 
 #include <cassert>
+#include <type_traits>
 #include <vector>
 
 namespace Typhoon::Reflection::detail {
@@ -53,9 +55,12 @@ public:
 		return nullptr;
 	}
 
+	void reserve(size_t count) override {
+		container->reserve(container->size() + count);
+	}
+
 	DataPtr pushBack() override {
-		container->resize(container->size() + 1);
-		return &container->back();
+		return &container->emplace_back();
 	}
 
 	bool isValid() const override {
@@ -82,6 +87,45 @@ public:
 		return allocator.make<WriteIteratorType>(cast<VECTOR_TYPE>(container));
 	}
 
+	bool isContiguous() const override {
+		// std::vector<bool> packs its values into bits
+		return ! std::is_same_v<typename VECTOR_TYPE::value_type, bool>;
+	}
+
+	DataPtr getElementData(DataPtr container) const override {
+		if constexpr (std::is_same_v<typename VECTOR_TYPE::value_type, bool>) {
+			return nullptr;
+		}
+		else {
+			return cast<VECTOR_TYPE>(container)->data();
+		}
+	}
+
+	ConstDataPtr getElementData(ConstDataPtr container) const override {
+		if constexpr (std::is_same_v<typename VECTOR_TYPE::value_type, bool>) {
+			return nullptr;
+		}
+		else {
+			return cast<VECTOR_TYPE>(container)->data();
+		}
+	}
+
+	size_t getElementCount(ConstDataPtr container) const override {
+		return cast<VECTOR_TYPE>(container)->size();
+	}
+
+	bool resize(DataPtr container, size_t count) const override {
+		cast<VECTOR_TYPE>(container)->resize(count);
+		return true;
+	}
+
+	bool bindArena([[maybe_unused]] DataPtr container, [[maybe_unused]] std::pmr::memory_resource& arena) const override {
+		if constexpr (UsesMemoryResource<VECTOR_TYPE>) {
+			return detail::bindArena(*cast<VECTOR_TYPE>(container), arena);
+		}
+		return true;
+	}
+
 private:
 	using ReadIteratorType = StdVectorReadIterator<VECTOR_TYPE>;
 	using WriteIteratorType = StdVectorWriteIterator<VECTOR_TYPE>;
@@ -101,4 +145,17 @@ struct autoRegisterHelper<std::vector<T>> {
 	}
 };
 
+// std::pmr::vector specialization
+template <class T>
+struct autoRegisterHelper<std::pmr::vector<T>> {
+	static const Type* autoRegister(Context& context) {
+		using ValueType = T;
+		using ContainerType = std::pmr::vector<T>;
+		const Type*      valueType = autoRegisterType<ValueType>(context);
+		constexpr TypeId typeID = getTypeId<ContainerType>();
+		const char*      typeName = decorateTypeName(valueType->getName(), "std::pmr::vector<", ">", *context.scopedAllocator);
+		return context.scopedAllocator->make<StdVectorContainer<ContainerType>>(typeName, typeID, valueType, *context.allocator);
+	}
+};
+
 } // namespace Typhoon::Reflection::detail
@@ -1,32 +1,89 @@
 #pragma once
 
+#include "hash.h"
 #include "type.h"
 #include <core/stdAllocator.h>
 
 #include <span>
+#include <string_view>
 #include <vector>
 
 namespace Typhoon::Reflection {
 
 class Property;
 
+// Precompiled step of a struct serialization plan
+struct PropertyOp {
+	enum class Code : uint8_t {
+		custom,    // the value type has a custom reader or writer
+		structure, // nested struct, executed through its own plan
+		generic,   // dispatched on the subclass of the value type
+	};
+	Code            code;
+	const Property* property;
+	const Type*     valueType;
+	size_t          fieldOffset; // Property::noFieldOffset if the value is accessed through the getter and setter
+	bool            hidden;      // inherited property with the same name as a property of a derived struct
+};
+
+// Bytes of a struct copied by cloneObject
+struct ByteRange {
+	size_t offset;
+	size_t size;
+};
+
 class StructType final : public Type {
 public:
 	StructType(const char* typeName, TypeId typeID, size_t size, size_t alignment, const StructType* parentType, const MethodTable& methods,
 	           Allocator& allocator);
 	~StructType();
 
-	const StructType*         getParentType() const;
-	bool                      inheritsFrom(const StructType* type) const;
-	Property&                 addProperty(Property&& property);
-	std::span<const Property> getProperties() const;
-	const Property*           getProperty(const char* propertyName) const;
+	const StructType*                getParentType() const;
+	bool                             inheritsFrom(const StructType* type) const;
+	Property&                        addProperty(Property&& property);
+	std::span<const Property>        getProperties() const;
+	// Own properties first, then inherited ones
+	std::span<const Property* const> getAllProperties() const;
+	// Find an own property. Inherited properties are not searched
+	const Property*                  getProperty(const char* propertyName) const;
+	// Find a property of this type or of its parent types. Own properties hide inherited ones with the same name
+	const Property*                  findProperty(std::string_view propertyName) const;
+	// nameHash must be hashString(propertyName), e.g. computed at compile time
+	const Property*                  findProperty(std::string_view propertyName, uint64_t nameHash) const;
+	// Flattened lists of readable and writeable properties, own properties first, then inherited ones
+	std::span<const PropertyOp>      getReadPlan() const;
+	std::span<const PropertyOp>      getWritePlan() const;
+	// Find the step of the read plan that reads a property. Own properties hide inherited ones with the same name
+	const PropertyOp*                findReadOp(std::string_view propertyName) const;
+	// True if all clonable properties, own and inherited, are data members of trivially copyable types. Cloning then copies the
+	// merged byte ranges of these members
+	bool                             isClonedByCopy() const;
+	std::span<const ByteRange>       getCloneRanges() const;
+	// True if cloning copies the whole struct, so that arrays of it can be cloned with a single memcpy
+	bool                             isMemoryCopyable() const;
+
+private:
+	void compilePlans() const;
 
 private:
 	using Vector = std::vector<Property, stdAllocator<Property>>;
+	using OpVector = std::vector<PropertyOp, stdAllocator<PropertyOp>>;
+	using PropertyPtrVector = std::vector<const Property*, stdAllocator<const Property*>>;
+	using RangeVector = std::vector<ByteRange, stdAllocator<ByteRange>>;
+
+	friend class TypeDB;
 
-	const StructType* parentType;
-	Vector            properties;
+	const StructType*                parentType;
+	Vector                           properties;
+	mutable OpVector                 readPlan;  // compiled when the type is registered, or on first use
+	mutable OpVector                 writePlan;
+	mutable PropertyPtrVector        flatProperties; // own properties first, then inherited ones
+	mutable detail::HashIndex        propertyIndex;  // indices into flatProperties, the first property of each name
+	mutable detail::HashIndex        readPlanIndex;  // indices into readPlan
+	mutable RangeVector              cloneRanges;    // sorted by offset
+	mutable bool                     clonedByCopy;
+	mutable bool                     plansCompiled;
+	mutable detail::PerfectHashTable frozenProperties; // built by TypeDB::freeze, replaces propertyIndex
 };
 
 } // namespace Typhoon::Reflection
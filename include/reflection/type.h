@@ -20,13 +20,14 @@ using MoveAssignment = void (*)(DataPtr, DataPtr b);
 using EqualityOperator = bool (*)(ConstDataPtr, ConstDataPtr b);
 
 struct MethodTable {
-	Constructor      defaultConstructor;
-	Destructor       destructor;
-	CopyConstructor  copyConstructor;
-	CopyAssignment   copyAssignment;
-	MoveConstructor  moveConstructor;
-	MoveAssignment   moveAssignment;
-	EqualityOperator equalityOperator;
+	Constructor      defaultConstructor = nullptr;
+	Destructor       destructor = nullptr;
+	CopyConstructor  copyConstructor = nullptr;
+	CopyAssignment   copyAssignment = nullptr;
+	MoveConstructor  moveConstructor = nullptr;
+	MoveAssignment   moveAssignment = nullptr;
+	EqualityOperator equalityOperator = nullptr;
+	bool             triviallyCopyable = false; // objects can be copied with memcpy
 };
 
 namespace detail {
@@ -100,6 +101,7 @@ template <typename Type>
 inline MethodTable buildMethodTable() {
 	return {
 		defaultConstruct<Type>, destruct<Type>, copyConstruct<Type>, copyAssign<Type>, moveConstruct<Type>, moveAssign<Type>, equalityOperator<Type>,
+		std::is_trivially_copyable_v<Type>,
 	};
 }
 
@@ -141,6 +143,7 @@ public:
 	void                              moveConstructObject(DataPtr object, DataPtr src) const;
 	void                              moveObject(DataPtr a, DataPtr b) const;
 	bool                              compareObjects(ConstDataPtr a, ConstDataPtr b) const;
+	bool                              isTriviallyCopyable() const;
 	void                              setCustomWriter(CustomWriter saver);
 	const CustomWriter&               getCustomWriter() const;
 	void                              setCustomReader(CustomReader loader);
@@ -3,11 +3,14 @@
 #include "config.h"
 
 #include "context.h"
+#include "hash.h"
 #include "type.h"
+#include "typeStats.h"
 #include <core/stdAllocator.h>
 #include <core/uncopyable.h>
 
 #include <cassert>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -19,16 +22,30 @@ namespace Typhoon::Reflection {
 
 class Namespace;
 
+namespace detail {
+
+struct OperationCounters;
+struct TypeCounters;
+enum class Operation;
+class StringTable;
+
+} // namespace detail
+
 class TypeDB : Uncopyable {
 public:
 	TypeDB(Allocator& allocator, ScopedAllocator& scopedAllocator);
+	~TypeDB();
 
-	void       registerType(const Type* type);
+	bool       registerType(const Type* type);
 	Namespace& getGlobalNamespace() const;
+	bool       freeze();
+	bool       isFrozen() const;
 
 	const Type& getType(TypeId typeID) const;
 	const Type* tryGetType(TypeId typeID) const;
 	const Type* tryGetType(const char* typeName) const;
+	const Type* tryGetType(std::string_view typeName) const;
+	const Type* tryGetType(std::string_view typeName, uint64_t typeNameHash) const;
 
 	template <class T>
 	const Type& getType() const {
@@ -40,9 +57,37 @@ public:
 		return tryGetType(getTypeId<T>());
 	}
 
+	// Return a copy of str shared by all equal strings, e.g. the names of variants. Thread safe. Strings are freed with the registry,
+	// so the table grows with the number of distinct strings, including those read from archives
+	const char* internString(std::string_view str) const;
+
+#if TY_REFLECTION_INSTRUMENTATION
+	TypeStats   getTypeStats(const Type& type) const;
+	void        resetTypeStats();
+	std::string exportTypeStats() const; // JSON, types sorted by decreasing time
+	// nullptr if the type is not registered
+	detail::OperationCounters* getOperationCounters(const Type& type, detail::Operation operation) const;
+#endif
+
 private:
+	uint32_t findTypeIndex(TypeId typeID) const;
+
+private:
+	Allocator&                                          allocator;
+	ScopedAllocator&                                    scopedAllocator;
 	std::vector<const Type*, stdAllocator<const Type*>> types;
+	detail::HashIndex                                   typeIdIndex;   // TypeId -> index in types
+	detail::HashIndex                                   typeNameIndex; // hashString(name) -> index in types
+	detail::PerfectHashTable                            frozenTypeIds;
+	detail::PerfectHashTable                            frozenTypeNames;
 	Namespace*                                          globalNamespace;
+	detail::StringTable*                                stringTable;
+	void*                                               frozenStorage; // shared by all perfect hash tables
+	size_t                                              frozenStorageSize;
+#if TY_REFLECTION_INSTRUMENTATION
+	std::vector<detail::TypeCounters*, stdAllocator<detail::TypeCounters*>> typeCounters; // same indices as types
+#endif
+	bool                                                frozen;
 };
 
 struct Context;
@@ -56,12 +101,17 @@ struct autoRegisterHelper {
 	}
 };
 
+// Register a type that callers rely on. Types cannot be added once the registry is frozen, which aborts in all builds
+void registerRequiredType(TypeDB& typeDB, const Type* type);
+
 template <class T>
 inline const Type* autoRegisterType(Context& context) {
 	const Type* type = context.typeDB->tryGetType<T>();
 	if (! type) {
 		type = autoRegisterHelper<T>::autoRegister(context);
-		context.typeDB->registerType(type);
+		if (type) {
+			registerRequiredType(*context.typeDB, type);
+		}
 	}
 	assert(type);
 	return type;
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "config.h"
+
+#if TY_REFLECTION_INSTRUMENTATION
+
+#include <cstdint>
+
+namespace Typhoon::Reflection {
+
+// Counters of an operation on the values of a type. Time, bytes and temporary memory include nested values
+struct OperationStats {
+	uint64_t callCount;
+	uint64_t nanoseconds;
+	uint64_t bytes;            // emitted or consumed, for archives that report them
+	uint64_t scratchHighWater; // peak use of the temporary allocator in a single call
+};
+
+struct TypeStats {
+	OperationStats write;
+	OperationStats read;
+	OperationStats clone;
+};
+
+} // namespace Typhoon::Reflection
+
+#endif
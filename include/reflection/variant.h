@@ -5,15 +5,39 @@
 #include <core/typeId.h>
 
 #include <cassert>
-#include <string>
+#include <cstddef>
+#include <new>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 
 namespace Typhoon::Reflection {
 
 class Type;
 
+namespace detail {
+
+inline constexpr char emptyString[] = "";
+
+// Return a copy of str that is shared by all equal strings and lives until the type registry is destroyed
+const char* internString(std::string_view str);
+
+// Storage of variant values that don't fit inline. Freed blocks are kept by the thread for reuse
+void* allocVariantBlock(size_t size, size_t alignment);
+void  freeVariantBlock(void* block, size_t size, size_t alignment);
+
+// Registry lookup, done when a variant changes type
+const Type* findVariantType(TypeId typeId);
+
+} // namespace detail
+
+// A value of any registered type with a name. Small values are stored inline, larger ones in a pooled heap block. The type is cached,
+// so that copies, comparisons and destruction don't access the registry
 class Variant {
 public:
+	static constexpr size_t inlineSize = 32;
+	static constexpr size_t inlineAlignment = alignof(std::max_align_t);
+
 	Variant();
 	Variant(const Variant& other);
 	Variant(Variant&& other) noexcept;
@@ -31,12 +55,15 @@ public:
 	TypeId getTypeId() const {
 		return typeId;
 	}
-	const std::string& getName() const;
-	void*              getStorage() {
-        return &storage;
+	// Interned, equal names have equal pointers
+	const char* getName() const {
+		return name;
+	}
+	void* getStorage() {
+		return external ? *reinterpret_cast<void**>(&storage) : &storage;
 	}
 	const void* getStorage() const {
-		return &storage;
+		return external ? *reinterpret_cast<void* const*>(&storage) : &storage;
 	}
 
 	template <class T>
@@ -53,48 +80,58 @@ public:
 	bool operator==(const Variant& other) const;
 	bool operator!=(const Variant& other) const;
 
+	static constexpr bool fitsInline(size_t size, size_t alignment) {
+		return size <= inlineSize && alignment <= inlineAlignment;
+	}
+
 private:
-	void destruct();
+	void* allocStorage(size_t size, size_t alignment);
+	void  setType(const Type* type, bool isTriviallyCopyable);
+	void  copyTrivial(const Variant& other);
+	void  destruct();
 
 private:
-	TypeId                         typeId;
-	std::string                    name;
-	alignas(max_align_t) std::byte storage[64];	
+	TypeId                             typeId;
+	const Type*                        type; // nullptr if the variant is empty
+	const char*                        name;
+	bool                               external; // storage holds a pointer to a heap block
+	bool                               trivial;  // empty, or an inline value that can be copied with memcpy
+	alignas(inlineAlignment) std::byte storage[inlineSize];
 };
 
 template <class T>
 inline Variant::Variant(T&& value, std::string_view name)
-    : typeId { nullTypeId }
-    , name { name } {
+    : Variant {} {
+	this->name = detail::internString(name);
 	set(std::forward<T>(value));
 }
 
 template <class T>
 inline void Variant::set(T&& value) {
 	using ValueType = std::decay_t<T>;
-	static_assert(sizeof(ValueType) <= sizeof(storage));
 	static_assert(std::is_copy_constructible_v<ValueType>);
 	if (typeId == Typhoon::getTypeId<ValueType>()) {
-		*reinterpret_cast<ValueType*>(&storage) = std::forward<T>(value);
+		*static_cast<ValueType*>(getStorage()) = std::forward<T>(value);
 	}
 	else {
 		destruct();
-		new (&storage) ValueType { std::forward<T>(value) };
+		new (allocStorage(sizeof(ValueType), alignof(ValueType))) ValueType { std::forward<T>(value) };
 		typeId = Typhoon::getTypeId<ValueType>();
+		setType(detail::findVariantType(typeId), std::is_trivially_copyable_v<ValueType>);
 	}
 }
 
 template <class T>
 inline const T& Variant::get() const {
 	assert(typeId == Typhoon::getTypeId<T>());
-	return *reinterpret_cast<const T*>(&storage);
+	return *static_cast<const T*>(getStorage());
 }
 
 template <class T>
 inline bool Variant::tryGet(T* valuePtr) const {
 	assert(valuePtr);
 	if (typeId == Typhoon::getTypeId<T>()) {
-		*valuePtr = *reinterpret_cast<const T*>(&storage);
+		*valuePtr = *static_cast<const T*>(getStorage());
 		return true;
 	}
 	return false;
@@ -4,6 +4,7 @@
 
 namespace Typhoon::Reflection {
 
+class Executor;
 class OutputArchive;
 class Type;
 struct Context;
@@ -11,6 +12,7 @@ struct Context;
 namespace detail {
 
 void writeData(ConstDataPtr data, const Type& type, OutputArchive& archive, const Context& context);
+void writeDataParallel(ConstDataPtr data, const Type& type, OutputArchive& archive, const Context& context, Executor& executor);
 
 } // namespace detail
 
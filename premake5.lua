@@ -9,6 +9,11 @@ newoption {
 	description = "Build the examples",
 }
 
+newoption {
+	trigger     = "with-benchmarks",
+	description = "Build the benchmark application",
+}
+
 -- Global settings
 local workspacePath = path.join("build", _ACTION)  -- e.g. build/vs2019 or build/xcode4
 
@@ -185,6 +190,17 @@ if _OPTIONS["with-tests"] then
 		externalincludedirs { "include", "external", }
 		links({"Reflection", "Catch", })
 		filter { filter_gmake }
-			links({"Core", "TinyXML"})
+			links({"Core", "TinyXML", "pthread"})
+		filter {}
+end
+
+if _OPTIONS["with-benchmarks"] then
+	project("Benchmark")
+		kind "ConsoleApp"
+		files "benchmark/**.*"
+		externalincludedirs { "include", "external", }
+		links({"Reflection", })
+		filter { filter_gmake }
+			links({"Core", "TinyXML", "pthread"})
 		filter {}
 end
@@ -193,6 +193,9 @@ bool XMLInputArchive::iterateChild(ArchiveIterator& it) const {
 	currentNode = childIt;
 	readElementType();
 	it.setNode(childIt);
+	// The element name is the key of object members
+	const tinyxml2::XMLElement* element = childIt->ToElement();
+	it.setKey(element ? element->Name() : nullptr);
 	return true;
 }
 
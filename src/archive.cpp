@@ -10,7 +10,40 @@ Context& getContext();
 }
 
 InputArchive::InputArchive()
-    : context { detail::getContext() } {
+    : context { detail::getContext() }
+    , arena { nullptr } {
+}
+
+bool InputArchive::readStable(const char*& str) const {
+	return read(str);
+}
+
+bool InputArchive::readStable(std::string_view& sv) const {
+	return read(sv);
+}
+
+bool InputArchive::readBlob(std::span<const std::byte>& /*blob*/) const {
+	return false;
+}
+
+bool InputArchive::canFork() const {
+	return false;
+}
+
+std::unique_ptr<InputArchive> InputArchive::fork(ArchiveIterator& /*it*/, size_t /*firstChild*/) const {
+	return nullptr;
+}
+
+size_t InputArchive::getBytesRead() const {
+	return 0;
+}
+
+void InputArchive::setArena(std::pmr::memory_resource* arena_) {
+	arena = arena_;
+}
+
+std::pmr::memory_resource* InputArchive::getArena() const {
+	return arena;
 }
 
 bool InputArchive::read(void* data, TypeId typeId) const {
@@ -40,6 +73,26 @@ OutputArchive::OutputArchive()
     : context { detail::getContext() } {
 }
 
+bool OutputArchive::writeBlob(const void* /*data*/, size_t /*size*/) {
+	return false;
+}
+
+bool OutputArchive::canCreateChunkArchive() const {
+	return false;
+}
+
+std::unique_ptr<OutputArchive> OutputArchive::createChunkArchive() const {
+	return nullptr;
+}
+
+bool OutputArchive::appendChunk(std::string_view /*chunk*/) {
+	return false;
+}
+
+size_t OutputArchive::getBytesWritten() const {
+	return 0;
+}
+
 void OutputArchive::write(const char* key, const void* data, TypeId typeId) {
 	setKey(key);
 	write(data, typeId);
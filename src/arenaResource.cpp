@@ -0,0 +1,43 @@
+#include "arenaResource.h"
+#include <cstdlib>
+
+namespace Typhoon::Reflection {
+
+ArenaResource::ArenaResource(LinearAllocator& arena, Allocator& fallbackAllocator)
+    : arena { arena }
+    , fallbackAllocator { fallbackAllocator }
+    , fallbackBlocks { stdAllocator<FallbackBlock>(fallbackAllocator) } {
+}
+
+ArenaResource::~ArenaResource() {
+	release();
+}
+
+void ArenaResource::release() {
+	arena.rewind();
+	for (const FallbackBlock& block : fallbackBlocks) {
+		fallbackAllocator.free(block.ptr, block.size);
+	}
+	fallbackBlocks.clear();
+}
+
+void* ArenaResource::do_allocate(size_t bytes, size_t alignment) {
+	if (void* ptr = arena.alloc(bytes, alignment); ptr) {
+		return ptr;
+	}
+	void* ptr = fallbackAllocator.alloc(bytes, alignment);
+	if (! ptr) {
+		std::abort(); // memory resources cannot return nullptr and exceptions are disabled
+	}
+	fallbackBlocks.push_back({ ptr, bytes });
+	return ptr;
+}
+
+void ArenaResource::do_deallocate(void* /*ptr*/, size_t /*bytes*/, size_t /*alignment*/) {
+}
+
+bool ArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
+
+} // namespace Typhoon::Reflection
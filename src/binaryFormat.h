@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Typhoon::Reflection::detail::binary {
+
+// Layout of a binary archive:
+//   header    : magic "TYRB", format version, flags, two reserved bytes
+//   key table : varint key count, then for each key its varint length, characters and a null terminator
+//   padding   : zeroes up to a multiple of dataAlignment
+//   root value
+//
+// Each value starts with a tag:
+//   null, falseValue, trueValue : no payload
+//   intNumber                   : zigzag encoded varint
+//   uintNumber                  : varint
+//   floatNumber, doubleNumber   : raw IEEE 754 bytes, little endian
+//   string                      : varint length, characters, null terminator
+//   array, object               : uint32 content size in bytes, uint32 element count, content
+//   blob                        : varint size in bytes, zeroes up to a multiple of dataAlignment from the root value, raw bytes
+// Object members are a varint index into the key table followed by a value. Attributes are members whose key starts with '@'
+
+constexpr char    magic[4] = { 'T', 'Y', 'R', 'B' };
+constexpr uint8_t version = 1;
+constexpr size_t  headerSize = 8;
+constexpr size_t  dataAlignment = 16;
+constexpr size_t  containerHeaderSize = 1 + 2 * sizeof(uint32_t);
+constexpr size_t  flagsOffset = sizeof(magic) + 1;
+constexpr uint8_t blobFlag = 1; // set if the archive contains blobs
+
+enum class Tag : uint8_t {
+	null,
+	falseValue,
+	trueValue,
+	intNumber,
+	uintNumber,
+	floatNumber,
+	doubleNumber,
+	string,
+	array,
+	object,
+	blob,
+};
+
+inline uint64_t zigzagEncode(int64_t value) {
+	return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t value) {
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Return a pointer past the varint, or nullptr if it is invalid or exceeds end
+inline const uint8_t* readVarint(const uint8_t* ptr, const uint8_t* end, uint64_t& value) {
+	uint64_t result = 0;
+	for (unsigned int shift = 0; shift < 64; shift += 7) {
+		if (ptr >= end) {
+			return nullptr;
+		}
+		const uint8_t byte = *ptr++;
+		result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			value = result;
+			return ptr;
+		}
+	}
+	return nullptr;
+}
+
+// Offset of the first byte of blob data at or after offset, both relative to the root value
+inline size_t alignBlobOffset(size_t offset) {
+	return (offset + dataAlignment - 1) & ~(dataAlignment - 1);
+}
+
+} // namespace Typhoon::Reflection::detail::binary
@@ -0,0 +1,492 @@
+#include "binaryInputArchive.h"
+
+#if TY_REFLECTION_BINARY
+
+#include "binaryFormat.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace Typhoon::Reflection {
+
+using namespace detail::binary;
+
+namespace {
+
+constexpr uint32_t anyKey = detail::HashIndex::invalidValue;
+
+Tag getTag(const uint8_t* value) {
+	return static_cast<Tag>(*value);
+}
+
+uint32_t getContainerCount(const uint8_t* value) {
+	uint32_t count;
+	std::memcpy(&count, value + 1 + sizeof(uint32_t), sizeof(count));
+	return count;
+}
+
+const uint8_t* getContainerContent(const uint8_t* value) {
+	return value + containerHeaderSize;
+}
+
+} // namespace
+
+BinaryInputArchive::BinaryInputArchive()
+    : begin { nullptr }
+    , end { nullptr }
+    , root { nullptr }
+    , keyIndex { *detail::getContext().allocator } {
+}
+
+BinaryInputArchive::~BinaryInputArchive() = default;
+
+ParseResult BinaryInputArchive::initialize(const void* data, size_t size) {
+	stack.clear();
+	keys.clear();
+	keyIndex.clear();
+	begin = static_cast<const uint8_t*>(data);
+	end = begin + size;
+	if (size < headerSize || std::memcmp(begin, magic, sizeof(magic)) != 0) {
+		return { false, "Not a binary archive", 0 };
+	}
+	if (begin[sizeof(magic)] != version) {
+		return { false, "Unsupported binary archive version", static_cast<int>(sizeof(magic)) };
+	}
+
+	const uint8_t* ptr = begin + headerSize;
+	uint64_t       keyCount = 0;
+	ptr = readVarint(ptr, keyCount);
+	for (uint64_t k = 0; ptr && k < keyCount; ++k) {
+		uint64_t length = 0;
+		ptr = readVarint(ptr, length);
+		if (! ptr || length >= static_cast<uint64_t>(end - ptr) || ptr[length] != 0) {
+			ptr = nullptr;
+			break;
+		}
+		keys.emplace_back(reinterpret_cast<const char*>(ptr), static_cast<size_t>(length));
+		keyIndex.insert(hashString(keys.back()), static_cast<uint32_t>(k));
+		ptr += length + 1;
+	}
+	if (! ptr) {
+		return { false, "Invalid key table", static_cast<int>(headerSize) };
+	}
+
+	const size_t rootOffset = (static_cast<size_t>(ptr - begin) + dataAlignment - 1) & ~(dataAlignment - 1);
+	if (rootOffset >= size) {
+		return { false, "Invalid root value", static_cast<int>(rootOffset) };
+	}
+	root = begin + rootOffset;
+	if (! skipValue(root)) {
+		return { false, "Invalid root value", static_cast<int>(rootOffset) };
+	}
+	pushValue(root);
+	return { true, "No error.", 0 };
+}
+
+ParseResult BinaryInputArchive::initializeFromFile(const char* fileName) {
+	if (! file.open(fileName)) {
+		return { false, "Cannot open file", 0 };
+	}
+	return initialize(file.getData(), file.getSize());
+}
+
+bool BinaryInputArchive::read(bool& b) const {
+	const Tag tag = getTag(stack.back().value);
+	if (tag == Tag::trueValue || tag == Tag::falseValue) {
+		b = (tag == Tag::trueValue);
+		return true;
+	}
+	return false;
+}
+
+bool BinaryInputArchive::read(int& i) const {
+	return readInteger(i);
+}
+
+bool BinaryInputArchive::read(unsigned int& ui) const {
+	return readInteger(ui);
+}
+
+bool BinaryInputArchive::read(int64_t& i64) const {
+	return readInteger(i64);
+}
+
+bool BinaryInputArchive::read(uint64_t& ui64) const {
+	return readInteger(ui64);
+}
+
+bool BinaryInputArchive::read(float& f) const {
+	return readReal(f);
+}
+
+bool BinaryInputArchive::read(double& d) const {
+	return readReal(d);
+}
+
+bool BinaryInputArchive::read(const char*& str) const {
+	std::string_view sv;
+	if (read(sv)) {
+		str = sv.data();
+		return true;
+	}
+	return false;
+}
+
+bool BinaryInputArchive::read(std::string_view& sv) const {
+	const uint8_t* value = stack.back().value;
+	if (getTag(value) == Tag::string) {
+		uint64_t length = 0;
+		// The extent of the string was checked when the value was pushed
+		const uint8_t* chars = readVarint(value + 1, length);
+		sv = { reinterpret_cast<const char*>(chars), static_cast<size_t>(length) };
+		return true;
+	}
+	return false;
+}
+
+bool BinaryInputArchive::readBlob(std::span<const std::byte>& blob) const {
+	const uint8_t* value = stack.back().value;
+	if (getTag(value) == Tag::blob) {
+		uint64_t size = 0;
+		// The extent of the blob was checked when the value was pushed
+		const uint8_t* data = getBlobData(value, size);
+		blob = { reinterpret_cast<const std::byte*>(data), static_cast<size_t>(size) };
+		return true;
+	}
+	return false;
+}
+
+bool BinaryInputArchive::canFork() const {
+	return true;
+}
+
+std::unique_ptr<InputArchive> BinaryInputArchive::fork(ArchiveIterator& it, size_t firstChild) const {
+	const uint8_t* const container = stack.back().value;
+	if (getTag(container) != Tag::array || firstChild >= getContainerCount(container)) {
+		return nullptr;
+	}
+	// Children are stored one after the other, skip the previous ones
+	const uint8_t* child = getContainerContent(container);
+	for (size_t i = 0; i < firstChild && child; ++i) {
+		child = skipValue(child);
+	}
+	if (! child || ! skipValue(child)) {
+		return nullptr;
+	}
+	auto archive = std::make_unique<BinaryInputArchive>();
+	archive->begin = begin;
+	archive->end = end;
+	archive->root = root;
+	archive->keys = keys;
+	for (size_t k = 0; k < keys.size(); ++k) {
+		archive->keyIndex.insert(hashString(keys[k]), static_cast<uint32_t>(k));
+	}
+	archive->pushValue(container);
+	archive->pushValue(child);
+	it.setIndex(firstChild);
+	it.setNode(const_cast<uint8_t*>(child));
+	return archive;
+}
+
+bool BinaryInputArchive::beginElement(const char* name) const {
+	assert(! stack.empty());
+	if (! isObject()) {
+		return false;
+	}
+	if (name) {
+		const uint32_t keyToken = findKeyToken(name);
+		return keyToken != detail::HashIndex::invalidValue && beginMember(keyToken);
+	}
+	StackItem& top = stack.back();
+	top.nextMember = getContainerContent(top.value);
+	top.nextMemberIndex = 0;
+	return beginMember(anyKey);
+}
+
+void BinaryInputArchive::endElement() const {
+	stack.pop_back();
+}
+
+bool BinaryInputArchive::isObject() const {
+	return getTag(stack.back().value) == Tag::object;
+}
+
+bool BinaryInputArchive::isArray() const {
+	return getTag(stack.back().value) == Tag::array;
+}
+
+ValueType BinaryInputArchive::getValueType() const {
+	switch (getTag(stack.back().value)) {
+	case Tag::null:
+		return ValueType::Null;
+	case Tag::falseValue:
+		return ValueType::False;
+	case Tag::trueValue:
+		return ValueType::True;
+	case Tag::intNumber:
+	case Tag::uintNumber:
+	case Tag::floatNumber:
+	case Tag::doubleNumber:
+		return ValueType::Number;
+	case Tag::string:
+		return ValueType::String;
+	case Tag::array:
+		return ValueType::Array;
+	case Tag::object:
+		return ValueType::Object;
+	case Tag::blob:
+		return ValueType::Blob;
+	default:
+		return ValueType::Undefined;
+	}
+}
+
+size_t BinaryInputArchive::getElementCount() const {
+	const uint8_t* value = stack.back().value;
+	if (getTag(value) == Tag::array || getTag(value) == Tag::object) {
+		return getContainerCount(value);
+	}
+	return 0;
+}
+
+bool BinaryInputArchive::iterateChild(ArchiveIterator& it) const {
+	const uint8_t* child = nullptr;
+	size_t         index = 0;
+	if (it.hasValidIndex()) {
+		// Children are stored one after the other, the next one follows the current one
+		child = skipValue(stack.back().value);
+		stack.pop_back();
+		index = it.getIndex() + 1;
+	}
+	const uint8_t* container = stack.back().value;
+	if (getTag(container) != Tag::array && getTag(container) != Tag::object) {
+		return false; // unsupported
+	}
+	if (index >= getContainerCount(container)) {
+		it.reset();
+		return false;
+	}
+	if (index == 0) {
+		child = getContainerContent(container);
+	}
+	if (getTag(container) == Tag::object) {
+		uint64_t key = 0;
+		child = readVarint(child, key);
+		if (! child || key >= keys.size()) {
+			it.reset();
+			return false;
+		}
+		it.setKey(keys[key].data());
+	}
+	if (! skipValue(child)) {
+		it.reset();
+		return false;
+	}
+	it.setIndex(index);
+	it.setNode(const_cast<uint8_t*>(child));
+	pushValue(child);
+	return true;
+}
+
+// Legacy
+bool BinaryInputArchive::iterateChild(ArchiveIterator&, const char*) const {
+	assert(false);
+	return false;
+}
+
+bool BinaryInputArchive::readAttribute(const char* name, bool& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool BinaryInputArchive::readAttribute(const char* name, int& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool BinaryInputArchive::readAttribute(const char* name, unsigned int& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool BinaryInputArchive::readAttribute(const char* name, float& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool BinaryInputArchive::readAttribute(const char* name, double& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool BinaryInputArchive::readAttribute(const char* name, const char*& str) const {
+	return readAttributeValue(name, str);
+}
+
+bool BinaryInputArchive::readAttribute(const char* name, std::string_view& sv) const {
+	return readAttributeValue(name, sv);
+}
+
+bool BinaryInputArchive::beginAttribute(const char* name) const {
+	attributeKey.assign(1, '@');
+	attributeKey += name;
+	const uint32_t keyToken = findKeyToken(attributeKey);
+	return keyToken != detail::HashIndex::invalidValue && isObject() && beginMember(keyToken);
+}
+
+bool BinaryInputArchive::beginMember(uint32_t keyToken) const {
+	StackItem&     top = stack.back();
+	const uint32_t count = getContainerCount(top.value);
+	const uint8_t* member = top.nextMember;
+	uint32_t       index = top.nextMemberIndex;
+	for (uint32_t n = 0; n < count; ++n, ++index) {
+		if (index == count) {
+			// Wrap around
+			index = 0;
+			member = getContainerContent(top.value);
+		}
+		uint64_t       key = 0;
+		const uint8_t* value = readVarint(member, key);
+		const uint8_t* next = value ? skipValue(value) : nullptr;
+		if (! next) {
+			return false; // malformed
+		}
+		if (key == keyToken || keyToken == anyKey) {
+			top.nextMember = next;
+			top.nextMemberIndex = index + 1;
+			pushValue(value);
+			return true;
+		}
+		member = next;
+	}
+	return false;
+}
+
+void BinaryInputArchive::pushValue(const uint8_t* value) const {
+	stack.push_back({ value, getContainerContent(value), 0 });
+}
+
+uint32_t BinaryInputArchive::findKeyToken(std::string_view key) const {
+	return keyIndex.find(hashString(key), [this, key](uint32_t value) { return keys[value] == key; });
+}
+
+const uint8_t* BinaryInputArchive::readVarint(const uint8_t* ptr, uint64_t& value) const {
+	return detail::binary::readVarint(ptr, end, value);
+}
+
+// Return a pointer past the end of value, or nullptr if value is invalid or exceeds the archive
+const uint8_t* BinaryInputArchive::skipValue(const uint8_t* value) const {
+	if (value >= end) {
+		return nullptr;
+	}
+	const size_t available = static_cast<size_t>(end - value);
+	uint64_t     length = 0;
+	switch (getTag(value)) {
+	case Tag::null:
+	case Tag::falseValue:
+	case Tag::trueValue:
+		return value + 1;
+	case Tag::intNumber:
+	case Tag::uintNumber:
+		return readVarint(value + 1, length);
+	case Tag::floatNumber:
+		return available > sizeof(float) ? value + 1 + sizeof(float) : nullptr;
+	case Tag::doubleNumber:
+		return available > sizeof(double) ? value + 1 + sizeof(double) : nullptr;
+	case Tag::string:
+		// Strings are returned as null terminated
+		if (const uint8_t* chars = readVarint(value + 1, length); chars && length < static_cast<uint64_t>(end - chars) && chars[length] == 0) {
+			return chars + length + 1;
+		}
+		return nullptr;
+	case Tag::array:
+	case Tag::object:
+		if (available >= containerHeaderSize) {
+			uint32_t contentSize;
+			std::memcpy(&contentSize, value + 1, sizeof(contentSize));
+			if (contentSize <= available - containerHeaderSize) {
+				return value + containerHeaderSize + contentSize;
+			}
+		}
+		return nullptr;
+	case Tag::blob:
+		if (const uint8_t* data = getBlobData(value, length); data) {
+			return data + length;
+		}
+		return nullptr;
+	default:
+		return nullptr;
+	}
+}
+
+const uint8_t* BinaryInputArchive::getBlobData(const uint8_t* value, uint64_t& size) const {
+	const uint8_t* ptr = readVarint(value + 1, size);
+	if (! ptr) {
+		return nullptr;
+	}
+	// Blobs are aligned relative to the root value, which is aligned in the archive
+	const size_t offset = alignBlobOffset(static_cast<size_t>(ptr - root));
+	if (offset > static_cast<size_t>(end - root) || size > static_cast<uint64_t>(end - root) - offset) {
+		return nullptr;
+	}
+	return root + offset;
+}
+
+template <class T>
+bool BinaryInputArchive::readInteger(T& value) const {
+	const uint8_t* ptr = stack.back().value;
+	uint64_t       bits = 0;
+	if (getTag(ptr) == Tag::intNumber && readVarint(ptr + 1, bits)) {
+		if (const int64_t i = zigzagDecode(bits); std::in_range<T>(i)) {
+			value = static_cast<T>(i);
+			return true;
+		}
+	}
+	else if (getTag(ptr) == Tag::uintNumber && readVarint(ptr + 1, bits)) {
+		if (std::in_range<T>(bits)) {
+			value = static_cast<T>(bits);
+			return true;
+		}
+	}
+	return false;
+}
+
+template <class T>
+bool BinaryInputArchive::readReal(T& value) const {
+	const uint8_t* ptr = stack.back().value;
+	uint64_t       bits = 0;
+	switch (getTag(ptr)) {
+	case Tag::floatNumber: {
+		float f;
+		std::memcpy(&f, ptr + 1, sizeof(f));
+		value = static_cast<T>(f);
+		return true;
+	}
+	case Tag::doubleNumber: {
+		double d;
+		std::memcpy(&d, ptr + 1, sizeof(d));
+		value = static_cast<T>(d);
+		return true;
+	}
+	case Tag::intNumber:
+		readVarint(ptr + 1, bits);
+		value = static_cast<T>(zigzagDecode(bits));
+		return true;
+	case Tag::uintNumber:
+		readVarint(ptr + 1, bits);
+		value = static_cast<T>(bits);
+		return true;
+	default:
+		return false;
+	}
+}
+
+template <class T>
+bool BinaryInputArchive::readAttributeValue(const char* name, T& value) const {
+	bool res = false;
+	if (beginAttribute(name)) {
+		res = read(value);
+		endElement();
+	}
+	return res;
+}
+
+} // namespace Typhoon::Reflection
+
+#endif
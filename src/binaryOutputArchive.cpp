@@ -0,0 +1,405 @@
+#include "binaryOutputArchive.h"
+
+#if TY_REFLECTION_BINARY
+
+#include "binaryFormat.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+namespace Typhoon::Reflection {
+
+using namespace detail::binary;
+
+static_assert(std::endian::native == std::endian::little, "Binary archives store numbers in little endian order");
+
+namespace {
+
+void appendVarint(std::string& buffer, uint64_t value) {
+	while (value >= 0x80) {
+		buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<char>(value));
+}
+
+template <class T>
+void appendRaw(std::string& buffer, T value) {
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+void patchRaw(std::string& buffer, size_t offset, T value) {
+	std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+} // namespace
+
+BinaryOutputArchive::BinaryOutputArchive(bool openRoot)
+    : keyIndex { *detail::getContext().allocator }
+    , endRoot { openRoot }
+    , hasBlobs { false } {
+	if (openRoot) {
+		beginObject(); // begin root
+	}
+}
+
+BinaryOutputArchive::~BinaryOutputArchive() = default;
+
+bool BinaryOutputArchive::saveToFile(const char* fileName) {
+	std::string   str = saveToString();
+	std::ofstream file(fileName, std::ios::binary);
+	if (file) {
+		file.write(str.data(), str.size());
+		file.close();
+		return true;
+	}
+	return false;
+}
+
+std::string BinaryOutputArchive::saveToString() {
+	if (endRoot) {
+		endObject();
+		endRoot = false;
+	}
+	assert(scopes.empty());
+
+	std::string str;
+	str.append(magic, sizeof(magic));
+	str.push_back(static_cast<char>(version));
+	str.push_back(static_cast<char>(hasBlobs ? blobFlag : 0));
+	str.append(headerSize - str.size(), '\0');
+	appendVarint(str, keys.size());
+	for (const std::string& key : keys) {
+		appendVarint(str, key.size());
+		str.append(key.data(), key.size() + 1); // with null terminator
+	}
+	// Align the root value so that the archive can be read in place from an aligned buffer
+	str.append((dataAlignment - str.size() % dataAlignment) % dataAlignment, '\0');
+	str.append(body);
+	return str;
+}
+
+void BinaryOutputArchive::setKey(const char* name) {
+	assert(name);
+	writeKey(name);
+}
+
+bool BinaryOutputArchive::beginObject() {
+	beginContainer(static_cast<uint8_t>(Tag::object));
+	return true;
+}
+
+void BinaryOutputArchive::endObject() {
+	assert(! scopes.empty() && ! scopes.back().isArray);
+	endContainer();
+}
+
+bool BinaryOutputArchive::beginArray() {
+	beginContainer(static_cast<uint8_t>(Tag::array));
+	return true;
+}
+
+void BinaryOutputArchive::endArray() {
+	assert(! scopes.empty() && scopes.back().isArray);
+	endContainer();
+}
+
+void BinaryOutputArchive::writeAttribute(const char* name, bool value) {
+	writeAttributeKey(name);
+	write(value);
+}
+
+void BinaryOutputArchive::writeAttribute(const char* name, int value) {
+	writeAttributeKey(name);
+	write(value);
+}
+
+void BinaryOutputArchive::writeAttribute(const char* name, unsigned int value) {
+	writeAttributeKey(name);
+	write(value);
+}
+
+void BinaryOutputArchive::writeAttribute(const char* name, float value) {
+	writeAttributeKey(name);
+	write(value);
+}
+
+void BinaryOutputArchive::writeAttribute(const char* name, double value) {
+	writeAttributeKey(name);
+	write(value);
+}
+
+void BinaryOutputArchive::writeAttribute(const char* name, const char* str) {
+	writeAttributeKey(name);
+	write(str);
+}
+
+void BinaryOutputArchive::write(bool value) {
+	beginValue(static_cast<uint8_t>(value ? Tag::trueValue : Tag::falseValue));
+}
+
+void BinaryOutputArchive::write(int value) {
+	write(static_cast<int64_t>(value));
+}
+
+void BinaryOutputArchive::write(unsigned int value) {
+	write(static_cast<uint64_t>(value));
+}
+
+void BinaryOutputArchive::write(int64_t value) {
+	beginValue(static_cast<uint8_t>(Tag::intNumber));
+	writeVarint(zigzagEncode(value));
+}
+
+void BinaryOutputArchive::write(uint64_t value) {
+	beginValue(static_cast<uint8_t>(Tag::uintNumber));
+	writeVarint(value);
+}
+
+void BinaryOutputArchive::write(float value) {
+	beginValue(static_cast<uint8_t>(Tag::floatNumber));
+	appendRaw(body, value);
+}
+
+void BinaryOutputArchive::write(double value) {
+	beginValue(static_cast<uint8_t>(Tag::doubleNumber));
+	appendRaw(body, value);
+}
+
+void BinaryOutputArchive::write(const char* str) {
+	if (str) {
+		write(std::string_view { str });
+	}
+	else {
+		beginValue(static_cast<uint8_t>(Tag::null));
+	}
+}
+
+void BinaryOutputArchive::write(std::string_view str) {
+	beginValue(static_cast<uint8_t>(Tag::string));
+	writeVarint(str.size());
+	body.append(str.data(), str.size());
+	body.push_back('\0');
+}
+
+bool BinaryOutputArchive::writeBlob(const void* data, size_t size) {
+	beginValue(static_cast<uint8_t>(Tag::blob));
+	writeVarint(size);
+	body.append(alignBlobOffset(body.size()) - body.size(), '\0');
+	body.append(static_cast<const char*>(data), size);
+	hasBlobs = true;
+	return true;
+}
+
+bool BinaryOutputArchive::canCreateChunkArchive() const {
+	return true;
+}
+
+std::unique_ptr<OutputArchive> BinaryOutputArchive::createChunkArchive() const {
+	// Chunks start with the keys of this archive, so that appendChunk can usually copy their values as they are
+	auto chunkArchive = std::make_unique<BinaryOutputArchive>(false);
+	for (const std::string& key : keys) {
+		chunkArchive->getKeyToken(key);
+	}
+	return chunkArchive;
+}
+
+bool BinaryOutputArchive::appendChunk(std::string_view chunk) {
+	const uint8_t* const begin = reinterpret_cast<const uint8_t*>(chunk.data());
+	const uint8_t* const end = begin + chunk.size();
+	if (chunk.size() < headerSize || std::memcmp(begin, magic, sizeof(magic)) != 0 || begin[sizeof(magic)] != version) {
+		return false;
+	}
+
+	// Map the key tokens of the chunk to the key tokens of this archive. Chunks start with the keys of this archive, and chunks
+	// of the same values add the same keys in the same order, so tokens usually map to themselves
+	std::vector<uint32_t> keyTokens;
+	bool                  sameTokens = true;
+	uint64_t              keyCount = 0;
+	const uint8_t*        ptr = readVarint(begin + headerSize, end, keyCount);
+	for (uint64_t k = 0; ptr && k < keyCount; ++k) {
+		uint64_t length = 0;
+		ptr = readVarint(ptr, end, length);
+		if (! ptr || length >= static_cast<uint64_t>(end - ptr)) {
+			return false;
+		}
+		keyTokens.push_back(getKeyToken({ reinterpret_cast<const char*>(ptr), static_cast<size_t>(length) }));
+		sameTokens = sameTokens && keyTokens.back() == k;
+		ptr += length + 1;
+	}
+	if (! ptr) {
+		return false;
+	}
+
+	const size_t rootOffset = alignBlobOffset(static_cast<size_t>(ptr - begin));
+	if (rootOffset > chunk.size() || chunk.size() - rootOffset < containerHeaderSize || begin[rootOffset] != static_cast<uint8_t>(Tag::array)) {
+		return false;
+	}
+	// Append the elements of the root array of the chunk to the current array
+	assert(! scopes.empty() && scopes.back().isArray);
+	const uint8_t* const root = begin + rootOffset;
+	uint32_t             contentSize = 0;
+	uint32_t             elementCount = 0;
+	std::memcpy(&contentSize, root + 1, sizeof(uint32_t));
+	std::memcpy(&elementCount, root + 1 + sizeof(uint32_t), sizeof(uint32_t));
+	// Blobs are aligned from the root value, so they stay aligned only if the chunk content is copied at the same alignment
+	const bool hasChunkBlobs = (begin[flagsOffset] & blobFlag) != 0;
+	if (sameTokens && (! hasChunkBlobs || (body.size() - containerHeaderSize) % dataAlignment == 0)) {
+		if (contentSize > static_cast<size_t>(end - root) - containerHeaderSize) {
+			return false;
+		}
+		body.append(reinterpret_cast<const char*>(root + containerHeaderSize), contentSize);
+		scopes.back().elementCount += elementCount;
+		hasBlobs = hasBlobs || hasChunkBlobs;
+		return true;
+	}
+	const uint8_t* value = root + containerHeaderSize;
+	for (uint32_t i = 0; value && i < elementCount; ++i) {
+		value = appendValue(value, root, end, keyTokens);
+	}
+	return value != nullptr;
+}
+
+size_t BinaryOutputArchive::getBytesWritten() const {
+	return body.size();
+}
+
+// Copy a value of a chunk, replacing its key tokens. Return a pointer past the end of value, or nullptr if value is invalid
+const uint8_t* BinaryOutputArchive::appendValue(const uint8_t* value, const uint8_t* root, const uint8_t* end,
+                                                const std::vector<uint32_t>& keyTokens) {
+	if (value >= end) {
+		return nullptr;
+	}
+	const uint8_t  tag = *value;
+	const uint8_t* ptr = value + 1;
+	uint64_t       number = 0;
+	switch (static_cast<Tag>(tag)) {
+	case Tag::null:
+	case Tag::falseValue:
+	case Tag::trueValue:
+		beginValue(tag);
+		return ptr;
+	case Tag::intNumber:
+	case Tag::uintNumber:
+		if (ptr = readVarint(ptr, end, number); ptr) {
+			beginValue(tag);
+			writeVarint(number);
+		}
+		return ptr;
+	case Tag::floatNumber:
+	case Tag::doubleNumber: {
+		const size_t size = static_cast<Tag>(tag) == Tag::floatNumber ? sizeof(float) : sizeof(double);
+		if (size > static_cast<size_t>(end - ptr)) {
+			return nullptr;
+		}
+		beginValue(tag);
+		body.append(reinterpret_cast<const char*>(ptr), size);
+		return ptr + size;
+	}
+	case Tag::string:
+		if (ptr = readVarint(ptr, end, number); ! ptr || number >= static_cast<uint64_t>(end - ptr)) {
+			return nullptr;
+		}
+		beginValue(tag);
+		writeVarint(number);
+		body.append(reinterpret_cast<const char*>(ptr), static_cast<size_t>(number) + 1); // with null terminator
+		return ptr + number + 1;
+	case Tag::array:
+	case Tag::object: {
+		if (containerHeaderSize > static_cast<size_t>(end - value)) {
+			return nullptr;
+		}
+		uint32_t elementCount = 0;
+		std::memcpy(&elementCount, value + 1 + sizeof(uint32_t), sizeof(uint32_t));
+		ptr = value + containerHeaderSize;
+		// Sizes are recomputed, as key tokens might be encoded with a different number of bytes
+		beginContainer(tag);
+		for (uint32_t i = 0; ptr && i < elementCount; ++i) {
+			if (static_cast<Tag>(tag) == Tag::object) {
+				if (ptr = readVarint(ptr, end, number); ! ptr || number >= keyTokens.size()) {
+					ptr = nullptr;
+					break;
+				}
+				writeKeyToken(keyTokens[static_cast<size_t>(number)]);
+			}
+			ptr = appendValue(ptr, root, end, keyTokens);
+		}
+		endContainer();
+		return ptr;
+	}
+	case Tag::blob: {
+		if (ptr = readVarint(ptr, end, number); ! ptr) {
+			return nullptr;
+		}
+		const size_t offset = alignBlobOffset(static_cast<size_t>(ptr - root));
+		if (offset > static_cast<size_t>(end - root) || number > static_cast<uint64_t>(end - root) - offset) {
+			return nullptr;
+		}
+		writeBlob(root + offset, static_cast<size_t>(number));
+		return root + offset + number;
+	}
+	}
+	return nullptr;
+}
+
+void BinaryOutputArchive::beginValue(uint8_t tag) {
+	if (! scopes.empty() && scopes.back().isArray) {
+		++scopes.back().elementCount;
+	}
+	body.push_back(static_cast<char>(tag));
+}
+
+void BinaryOutputArchive::beginContainer(uint8_t tag) {
+	beginValue(tag);
+	scopes.push_back({ body.size() - 1, 0, tag == static_cast<uint8_t>(Tag::array) });
+	// Content size and element count, patched by endContainer
+	appendRaw<uint32_t>(body, 0);
+	appendRaw<uint32_t>(body, 0);
+}
+
+void BinaryOutputArchive::endContainer() {
+	const Scope& scope = scopes.back();
+	const size_t contentSize = body.size() - scope.offset - containerHeaderSize;
+	assert(contentSize <= UINT32_MAX);
+	patchRaw(body, scope.offset + 1, static_cast<uint32_t>(contentSize));
+	patchRaw(body, scope.offset + 1 + sizeof(uint32_t), scope.elementCount);
+	scopes.pop_back();
+}
+
+void BinaryOutputArchive::writeVarint(uint64_t value) {
+	appendVarint(body, value);
+}
+
+void BinaryOutputArchive::writeKey(std::string_view key) {
+	writeKeyToken(getKeyToken(key));
+}
+
+void BinaryOutputArchive::writeKeyToken(uint32_t token) {
+	assert(! scopes.empty() && ! scopes.back().isArray);
+	++scopes.back().elementCount;
+	writeVarint(token);
+}
+
+void BinaryOutputArchive::writeAttributeKey(const char* name) {
+	attributeKey.assign(1, '@');
+	attributeKey += name;
+	writeKey(attributeKey);
+}
+
+uint32_t BinaryOutputArchive::getKeyToken(std::string_view key) {
+	const uint64_t hash = hashString(key);
+	uint32_t       token = keyIndex.find(hash, [this, key](uint32_t value) { return keys[value] == key; });
+	if (token == detail::HashIndex::invalidValue) {
+		token = static_cast<uint32_t>(keys.size());
+		keys.emplace_back(key);
+		keyIndex.insert(hash, token);
+	}
+	return token;
+}
+
+} // namespace Typhoon::Reflection
+
+#endif
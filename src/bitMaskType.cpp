@@ -6,10 +6,20 @@ namespace Typhoon::Reflection {
 
 BitMaskType::BitMaskType(const char* typeName, TypeId typeID, const Type* underlyingType, const BitMaskConstant enumerators[], size_t numEnumerators,
                          Allocator& allocator)
-    : Type(typeName, typeID, Subclass::BitMask, underlyingType->getSize(), underlyingType->getAlignment(), {}, allocator)
+    : Type(typeName, typeID, Subclass::BitMask, underlyingType->getSize(), underlyingType->getAlignment(),
+           MethodTable { .triviallyCopyable = true }, allocator)
     , underlyingType(underlyingType)
     , enumerators(enumerators)
-    , numEnumerators(numEnumerators) {
+    , numEnumerators(numEnumerators)
+    , nameIndex(allocator) {
+	for (size_t i = 0; i < numEnumerators; ++i) {
+		const std::string_view name = enumerators[i].name;
+		const uint64_t         hash = hashString(name);
+		// Keep the first of duplicated names
+		if (nameIndex.find(hash, [=](uint32_t e) { return enumerators[e].name == name; }) == detail::HashIndex::invalidValue) {
+			nameIndex.insert(hash, static_cast<uint32_t>(i));
+		}
+	}
 }
 
 std::span<const BitMaskConstant> BitMaskType::getEnumerators() const {
@@ -25,14 +35,10 @@ const char* BitMaskType::findConstantByValue(BitMaskStorageType value) const {
 	return nullptr;
 }
 
-BitMaskStorageType BitMaskType::findConstantByName(const char* enumeratorName) const {
-	assert(enumeratorName);
-	for (size_t i = 0; i < numEnumerators; ++i) {
-		if (strcmp(enumerators[i].name, enumeratorName) == 0) {
-			return enumerators[i].mask;
-		}
-	}
-	return 0;
+BitMaskStorageType BitMaskType::findConstantByName(std::string_view enumeratorName) const {
+	const uint32_t index =
+	    nameIndex.find(hashString(enumeratorName), [this, enumeratorName](uint32_t i) { return enumerators[i].name == enumeratorName; });
+	return index != detail::HashIndex::invalidValue ? enumerators[index].mask : 0;
 }
 
 const Type& BitMaskType::getUnderlyingType() const {
@@ -5,6 +5,7 @@
 #include "containerType.h"
 #include "enumType.h"
 #include "flags.h"
+#include "instrumentation.h"
 #include "pointerType.h"
 #include "property.h"
 #include "referenceType.h"
@@ -36,6 +37,10 @@ void      cloneVariant(DataPtr dstData, ConstDataPtr srcData, const TypeDB& type
 ErrorCode cloneObject(DataPtr dstObject, ConstDataPtr srcObject, const Type& type) {
 	ErrorCode     errorCode;
 	if (const CustomCloner& customCloner = type.getCustomCloner(); customCloner) {
+#if TY_REFLECTION_INSTRUMENTATION
+		const Context&               context = detail::getContext();
+		detail::InstrumentationScope instrumentationScope { detail::Operation::clone, type, *context.typeDB, *context.pagedAllocator };
+#endif
 		customCloner(dstObject, srcObject);
 		errorCode = ErrorCode::ok;
 	}
@@ -48,7 +53,10 @@ ErrorCode cloneObject(DataPtr dstObject, ConstDataPtr srcObject, const Type& typ
 namespace {
 
 ErrorCode cloneObjectImpl(DataPtr dstData, ConstDataPtr srcData, const Type& type, LinearAllocator& allocator) {
-	const TypeDB&        typeDB = detail::getTypeDB();
+	const TypeDB& typeDB = detail::getTypeDB();
+#if TY_REFLECTION_INSTRUMENTATION
+	detail::InstrumentationScope instrumentationScope { detail::Operation::clone, type, typeDB, allocator };
+#endif
 	const Type::Subclass subclass = type.getSubClass();
 	if (subclass == Type::Subclass::Builtin) {
 		cloneBuiltin(dstData, srcData, static_cast<const BuiltinType&>(type));
@@ -77,10 +85,44 @@ ErrorCode cloneObjectImpl(DataPtr dstData, ConstDataPtr srcData, const Type& typ
 	return ErrorCode::ok;
 }
 
+void cloneField(DataPtr dstData, ConstDataPtr srcData, const Property& property, LinearAllocator& allocator) {
+	// Same as copying through the getter and setter of the data member, without the temporary
+	const Type&  valueType = property.getValueType();
+	DataPtr      dstField = advancePointer(dstData, property.getFieldOffset());
+	ConstDataPtr srcField = advancePointer(srcData, property.getFieldOffset());
+	switch (valueType.getSubClass()) {
+	case Type::Subclass::Enum:
+	case Type::Subclass::BitMask:
+		std::memcpy(dstField, srcField, valueType.getSize());
+		break;
+	case Type::Subclass::Pointer:
+	case Type::Subclass::Reference:
+		// No method table
+		property.copyValue(dstData, srcData, allocator);
+		break;
+	default:
+		valueType.copyObject(dstField, srcField);
+		break;
+	}
+}
+
 void cloneStruct(DataPtr dstData, ConstDataPtr srcData, const StructType& structType, const TypeDB& typeDB, LinearAllocator& allocator) {
+	if (structType.isClonedByCopy()) {
+		// Plain data members only, including inherited ones
+		for (const ByteRange& range : structType.getCloneRanges()) {
+			std::memcpy(advancePointer(dstData, range.offset), advancePointer(srcData, range.offset), range.size);
+		}
+		return;
+	}
+
 	for (const auto& property : structType.getProperties()) {
 		if (property.getFlags() & Flags::clonable) {
-			property.copyValue(dstData, srcData, allocator);
+			if (property.isField()) {
+				cloneField(dstData, srcData, property, allocator);
+			}
+			else {
+				property.copyValue(dstData, srcData, allocator);
+			}
 		}
 	}
 
@@ -101,14 +143,39 @@ void cloneBitMask(DataPtr data, ConstDataPtr srcData, const BitMaskType& type) {
 	std::memcpy(data, srcData, type.getSize());
 }
 
+bool isMemoryCopyable(const Type& type) {
+	const Type::Subclass subclass = type.getSubClass();
+	if (subclass == Type::Subclass::Struct) {
+		// Unless all of their bytes are clonable fields
+		return static_cast<const StructType&>(type).isMemoryCopyable();
+	}
+	return type.isTriviallyCopyable() && (subclass == Type::Subclass::Builtin || subclass == Type::Subclass::Enum || subclass == Type::Subclass::BitMask);
+}
+
 void cloneContainer(DataPtr dstContainer, ConstDataPtr srcContainer, const ContainerType& type, LinearAllocator& allocator) {
 	const Type* key_type = type.getKeyType();
 	const Type* value_type = type.getValueType();
 
+	if (type.isContiguous() && isMemoryCopyable(*value_type)) {
+		// Copy all values at once
+		const size_t count = type.getElementCount(srcContainer);
+		if (type.resize(dstContainer, count)) {
+			if (count) {
+				std::memcpy(type.getElementData(dstContainer), type.getElementData(srcContainer), count * value_type->getSize());
+			}
+			return;
+		}
+	}
+
+	if (type.isContiguous()) {
+		// Values replace the content of the container, as above. Fixed size arrays ignore this
+		type.resize(dstContainer, 0);
+	}
+
 	ScopedAllocator      scopedAllocator(allocator);
 	WriteIterator* const writeIterator = type.newWriteIterator(dstContainer, scopedAllocator);
 	ReadIterator* const  readIterator = type.newReadIterator(srcContainer, scopedAllocator);
-	//type.clear(dstContainer);
+	writeIterator->reserve(readIterator->getCount());
 
 	while (readIterator->isValid()) {
 		if (key_type) {
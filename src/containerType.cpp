@@ -2,10 +2,37 @@
 
 namespace Typhoon::Reflection {
 
+void WriteIterator::reserve(size_t /*count*/) {
+}
+
 ContainerType::ContainerType(const char* typeName, TypeId typeID, size_t size, const Type* keyType, const Type* valueType, const MethodTable& methods, Allocator& allocator)
     : Type(typeName, typeID, Subclass::Container, size, 16, methods, allocator)
     , keyType(keyType)
     , valueType(valueType) {
 }
 
+bool ContainerType::isContiguous() const {
+	return false;
+}
+
+DataPtr ContainerType::getElementData(DataPtr /*container*/) const {
+	return nullptr;
+}
+
+ConstDataPtr ContainerType::getElementData(ConstDataPtr /*container*/) const {
+	return nullptr;
+}
+
+size_t ContainerType::getElementCount(ConstDataPtr /*container*/) const {
+	return 0;
+}
+
+bool ContainerType::resize(DataPtr /*container*/, size_t /*count*/) const {
+	return false;
+}
+
+bool ContainerType::bindArena(DataPtr /*container*/, std::pmr::memory_resource& /*arena*/) const {
+	return true;
+}
+
 } // namespace Typhoon::Reflection
@@ -1,15 +1,45 @@
 #include "enumType.h"
+#include <algorithm>
 #include <cassert>
+#include <type_traits>
 
 namespace Typhoon::Reflection {
 
+namespace {
+
+constexpr uint32_t invalidIndex = UINT32_MAX;
+// Values are indexed by a dense table if at least half of its entries are used
+constexpr uint64_t maxDenseRangeFactor = 2;
+
+bool isSignedInteger(TypeId typeId) {
+	return typeId == getTypeId<signed char>() || typeId == getTypeId<short>() || typeId == getTypeId<int>() || typeId == getTypeId<long>()
+	    || typeId == getTypeId<long long>() || (std::is_signed_v<char> && typeId == getTypeId<char>());
+}
+
+template <class T>
+int64_t loadInteger(ConstDataPtr value) {
+	T v;
+	std::memcpy(&v, value, sizeof v);
+	return static_cast<int64_t>(v);
+}
+
+} // namespace
+
 EnumType::EnumType(const char* typeName, TypeId typeID, size_t size, size_t alignment, const Enumerator enumConstants[], size_t count,
                    const Type* underlyingType, Allocator& allocator)
-    : Type(typeName, typeID, Subclass::Enum, size, alignment, {}, allocator)
+    : Type(typeName, typeID, Subclass::Enum, size, alignment, MethodTable { .triviallyCopyable = true }, allocator)
     , enumerators(enumConstants)
     , numEnumerators(count)
-    , underlyingType(underlyingType) {
+    , underlyingType(underlyingType)
+    , signedValues(false)
+    , minValue(0)
+    , denseIndices(stdAllocator<uint32_t>(allocator))
+    , sortedValues(stdAllocator<ValueEntry>(allocator))
+    , nameIndex(allocator) {
 	assert(underlyingType);
+	signedValues = isSignedInteger(underlyingType->getTypeId());
+	buildValueIndex();
+	buildNameIndex();
 }
 
 std::span<const Enumerator> EnumType::getEnumerators() const {
@@ -17,25 +47,87 @@ std::span<const Enumerator> EnumType::getEnumerators() const {
 }
 
 const Enumerator* EnumType::findEnumeratorByValue(ConstDataPtr value, size_t valueSize) const {
-	for (size_t i = 0; i < numEnumerators; ++i) {
-		if (std::memcmp(enumerators[i].value, value, valueSize) == 0) {
-			return &enumerators[i];
+	if (valueSize != getSize()) {
+		for (size_t i = 0; i < numEnumerators; ++i) {
+			if (std::memcmp(enumerators[i].value, value, valueSize) == 0) {
+				return &enumerators[i];
+			}
 		}
+		return nullptr;
+	}
+	const int64_t key = loadValue(value);
+	if (! denseIndices.empty()) {
+		const uint64_t offset = static_cast<uint64_t>(key) - static_cast<uint64_t>(minValue);
+		const uint32_t index = offset < denseIndices.size() ? denseIndices[offset] : invalidIndex;
+		return index != invalidIndex ? &enumerators[index] : nullptr;
 	}
-	return nullptr;
+	// Duplicated values are sorted by enumerator index, so the first enumerator is found, as linear searches did
+	auto it = std::lower_bound(sortedValues.begin(), sortedValues.end(), key, [](const ValueEntry& e, int64_t v) { return e.value < v; });
+	return it != sortedValues.end() && it->value == key ? &enumerators[it->index] : nullptr;
 }
 
 const Enumerator* EnumType::findEnumeratorByName(const char* constantName) const {
-	for (size_t i = 0; i < numEnumerators; ++i) {
-		if (strcmp(enumerators[i].name, constantName) == 0) {
-			return &enumerators[i];
-		}
+	const uint64_t hash = hashString(constantName);
+	if (frozenEnumerators.isValid()) {
+		const uint32_t index = frozenEnumerators.find(hash);
+		return index != detail::PerfectHashTable::invalidValue && ! strcmp(enumerators[index].name, constantName) ? &enumerators[index] : nullptr;
 	}
-	return nullptr;
+	const uint32_t index = nameIndex.find(hash, [this, constantName](uint32_t i) { return ! strcmp(enumerators[i].name, constantName); });
+	return index != detail::HashIndex::invalidValue ? &enumerators[index] : nullptr;
 }
 
 const Type& EnumType::getUnderlyingType() const {
 	return *underlyingType;
 }
 
+int64_t EnumType::loadValue(ConstDataPtr value) const {
+	switch (getSize()) {
+	case 1:
+		return signedValues ? loadInteger<int8_t>(value) : loadInteger<uint8_t>(value);
+	case 2:
+		return signedValues ? loadInteger<int16_t>(value) : loadInteger<uint16_t>(value);
+	case 4:
+		return signedValues ? loadInteger<int32_t>(value) : loadInteger<uint32_t>(value);
+	default:
+		assert(getSize() == 8);
+		return loadInteger<int64_t>(value);
+	}
+}
+
+void EnumType::buildValueIndex() {
+	if (numEnumerators == 0) {
+		return;
+	}
+	sortedValues.reserve(numEnumerators);
+	for (size_t i = 0; i < numEnumerators; ++i) {
+		sortedValues.push_back({ loadValue(enumerators[i].value), static_cast<uint32_t>(i) });
+	}
+	std::stable_sort(sortedValues.begin(), sortedValues.end(), [](const ValueEntry& a, const ValueEntry& b) { return a.value < b.value; });
+
+	minValue = sortedValues.front().value;
+	const uint64_t range = static_cast<uint64_t>(sortedValues.back().value) - static_cast<uint64_t>(minValue);
+	if (range < maxDenseRangeFactor * numEnumerators) {
+		denseIndices.assign(range + 1, invalidIndex);
+		for (const ValueEntry& entry : sortedValues) {
+			// Keep the first enumerator of duplicated values
+			if (uint32_t& index = denseIndices[static_cast<uint64_t>(entry.value) - static_cast<uint64_t>(minValue)]; index == invalidIndex) {
+				index = entry.index;
+			}
+		}
+		sortedValues.clear();
+		sortedValues.shrink_to_fit();
+	}
+}
+
+void EnumType::buildNameIndex() {
+	for (size_t i = 0; i < numEnumerators; ++i) {
+		const char*    name = enumerators[i].name;
+		const uint64_t hash = hashString(name);
+		// Keep the first of duplicated names
+		if (nameIndex.find(hash, [this, name](uint32_t e) { return ! strcmp(enumerators[e].name, name); }) == detail::HashIndex::invalidValue) {
+			nameIndex.insert(hash, static_cast<uint32_t>(i));
+		}
+	}
+}
+
 } // namespace Typhoon::Reflection
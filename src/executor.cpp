@@ -0,0 +1,39 @@
+#include "executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Typhoon::Reflection {
+
+ThreadExecutor::ThreadExecutor(size_t threadCount)
+    : threadCount { threadCount ? threadCount : std::max(std::thread::hardware_concurrency(), 1u) } {
+}
+
+size_t ThreadExecutor::getConcurrency() const {
+	return threadCount;
+}
+
+void ThreadExecutor::run(size_t taskCount, const std::function<void(size_t)>& task) {
+	// Threads pick the next task as they become free, so that uneven tasks are balanced
+	std::atomic<size_t> nextTask { 0 };
+	auto worker = [&nextTask, taskCount, &task]() {
+		for (size_t index = nextTask++; index < taskCount; index = nextTask++) {
+			task(index);
+		}
+	};
+	const size_t             threadsToStart = std::min(threadCount, taskCount);
+	std::vector<std::thread> threads;
+	threads.reserve(threadsToStart);
+	// The calling thread works too
+	for (size_t t = 1; t < threadsToStart; ++t) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+} // namespace Typhoon::Reflection
@@ -0,0 +1,142 @@
+#include "hash.h"
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace Typhoon::Reflection::detail {
+
+HashIndex::HashIndex(Allocator& allocator)
+    : slots { stdAllocator<Slot>(allocator) }
+    , count { 0 } {
+}
+
+void HashIndex::insert(uint64_t hash, uint32_t value) {
+	assert(value != invalidValue);
+	if ((count + 1) * 2 > slots.size()) {
+		rehash(slots.empty() ? 16 : slots.size() * 2);
+	}
+	const size_t mask = slots.size() - 1;
+	size_t       i = hash & mask;
+	while (slots[i].value != invalidValue) {
+		i = (i + 1) & mask;
+	}
+	slots[i] = { hash, value };
+	++count;
+}
+
+void HashIndex::clear() {
+	slots.clear();
+	count = 0;
+}
+
+size_t HashIndex::size() const {
+	return count;
+}
+
+void HashIndex::rehash(size_t newCapacity) {
+	assert((newCapacity & (newCapacity - 1)) == 0);
+	decltype(slots) oldSlots { std::move(slots) };
+	slots = decltype(slots)(newCapacity, Slot { 0, invalidValue }, oldSlots.get_allocator());
+	count = 0;
+	for (const Slot& slot : oldSlots) {
+		if (slot.value != invalidValue) {
+			insert(slot.hash, slot.value);
+		}
+	}
+}
+
+namespace {
+
+size_t nextPowerOfTwo(size_t n) {
+	size_t p = 1;
+	while (p < n) {
+		p *= 2;
+	}
+	return p;
+}
+
+// Load factor at most 1/2, about four hashes per bucket
+size_t getSlotCount(size_t entryCount) {
+	return nextPowerOfTwo(std::max<size_t>(entryCount * 2, 1));
+}
+
+size_t getBucketCount(size_t entryCount) {
+	return nextPowerOfTwo(std::max<size_t>((entryCount + 3) / 4, 1));
+}
+
+constexpr uint32_t maxSeed = 1 << 16;
+
+} // namespace
+
+size_t PerfectHashTable::getStorageSize(size_t entryCount) {
+	return getSlotCount(entryCount) * sizeof(Entry) + getBucketCount(entryCount) * sizeof(uint32_t);
+}
+
+bool PerfectHashTable::build(std::span<const Entry> entries, void* storage, Allocator& tempAllocator) {
+	assert(storage);
+	const size_t slotCount = getSlotCount(entries.size());
+	const size_t bucketCount = getBucketCount(entries.size());
+	Entry*       slotArray = static_cast<Entry*>(storage);
+	uint32_t*    seedArray = reinterpret_cast<uint32_t*>(slotArray + slotCount);
+	std::fill_n(slotArray, slotCount, Entry { 0, invalidValue });
+	std::fill_n(seedArray, bucketCount, 0);
+
+	auto getBucket = [bucketCount](uint64_t hash) { return static_cast<size_t>(hash >> 32) & (bucketCount - 1); };
+
+	// Place the largest buckets first, while most slots are still free
+	std::vector<uint32_t, stdAllocator<uint32_t>> bucketSizes(bucketCount, 0, stdAllocator<uint32_t>(tempAllocator));
+	for (const Entry& entry : entries) {
+		assert(entry.value != invalidValue);
+		++bucketSizes[getBucket(entry.hash)];
+	}
+	std::vector<uint32_t, stdAllocator<uint32_t>> order(entries.size(), 0, stdAllocator<uint32_t>(tempAllocator));
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+		const size_t bucketA = getBucket(entries[a].hash);
+		const size_t bucketB = getBucket(entries[b].hash);
+		if (bucketSizes[bucketA] != bucketSizes[bucketB]) {
+			return bucketSizes[bucketA] > bucketSizes[bucketB];
+		}
+		return bucketA != bucketB ? bucketA < bucketB : entries[a].hash < entries[b].hash;
+	});
+
+	std::vector<size_t, stdAllocator<size_t>> bucketSlots { stdAllocator<size_t>(tempAllocator) };
+	for (size_t first = 0; first < order.size();) {
+		const size_t bucket = getBucket(entries[order[first]].hash);
+		const size_t last = first + bucketSizes[bucket];
+		for (size_t i = first + 1; i < last; ++i) {
+			if (entries[order[i]].hash == entries[order[i - 1]].hash) {
+				return false; // duplicate hash
+			}
+		}
+
+		bool placed = false;
+		for (uint32_t seed = 0; seed < maxSeed && ! placed; ++seed) {
+			bucketSlots.clear();
+			placed = true;
+			for (size_t i = first; i < last && placed; ++i) {
+				const size_t slot = getSlotIndex(entries[order[i]].hash, seed, slotCount - 1);
+				placed = slotArray[slot].value == invalidValue && std::find(bucketSlots.begin(), bucketSlots.end(), slot) == bucketSlots.end();
+				bucketSlots.push_back(slot);
+			}
+			if (placed) {
+				for (size_t i = first; i < last; ++i) {
+					slotArray[bucketSlots[i - first]] = entries[order[i]];
+				}
+				seedArray[bucket] = seed;
+			}
+		}
+		if (! placed) {
+			return false;
+		}
+		first = last;
+	}
+
+	slots = slotArray;
+	seeds = seedArray;
+	slotMask = slotCount - 1;
+	bucketMask = bucketCount - 1;
+	return true;
+}
+
+} // namespace Typhoon::Reflection::detail
@@ -0,0 +1,147 @@
+#include "instrumentation.h"
+
+#if TY_REFLECTION_INSTRUMENTATION
+
+#include "archive.h"
+#include "context.h"
+#include "typeDB.h"
+#include <algorithm>
+
+namespace Typhoon::Reflection::detail {
+
+Context& getContext();
+
+OperationStats loadStats(const OperationCounters& counters) {
+	return { counters.callCount.load(std::memory_order_relaxed), counters.nanoseconds.load(std::memory_order_relaxed),
+		     counters.bytes.load(std::memory_order_relaxed), counters.scratchHighWater.load(std::memory_order_relaxed) };
+}
+
+void resetCounters(OperationCounters& counters) {
+	counters.callCount.store(0, std::memory_order_relaxed);
+	counters.nanoseconds.store(0, std::memory_order_relaxed);
+	counters.bytes.store(0, std::memory_order_relaxed);
+	counters.scratchHighWater.store(0, std::memory_order_relaxed);
+}
+
+ScratchTracker::ScratchTracker(Allocator& parentAllocator, size_t pageSize)
+    : pagedAllocator { parentAllocator, pageSize }
+    , usedBytes { 0 }
+    , peakBytes { 0 } {
+}
+
+void* ScratchTracker::alloc(size_t size, size_t alignment) {
+	void* const offset = pagedAllocator.getOffset();
+	void*       ptr = pagedAllocator.alloc(size, alignment);
+	if (ptr) {
+		marks.push_back({ offset, ptr, usedBytes });
+		usedBytes += size;
+		peakBytes = std::max(peakBytes, usedBytes);
+	}
+	return ptr;
+}
+
+void ScratchTracker::rewind() {
+	pagedAllocator.rewind();
+	marks.clear();
+	usedBytes = 0;
+}
+
+void ScratchTracker::rewind(void* ptr) {
+	pagedAllocator.rewind(ptr);
+	// Pointers of different pages cannot be compared, so search the first allocation made at ptr. Allocations of no bytes share
+	// their offset with the next one
+	size_t first = marks.size();
+	for (size_t i = marks.size(); i > 0; --i) {
+		const Mark& mark = marks[i - 1];
+		if (mark.offset == ptr || mark.ptr == ptr) {
+			first = i - 1;
+		}
+		else if (first != marks.size()) {
+			break;
+		}
+	}
+	if (first != marks.size()) {
+		usedBytes = marks[first].usedBytes;
+		marks.resize(first);
+	}
+}
+
+void* ScratchTracker::getOffset() const {
+	return pagedAllocator.getOffset();
+}
+
+size_t ScratchTracker::getUsedBytes() const {
+	return usedBytes;
+}
+
+size_t ScratchTracker::getPeakBytes() const {
+	return peakBytes;
+}
+
+void ScratchTracker::setPeakBytes(size_t bytes) {
+	peakBytes = bytes;
+}
+
+InstrumentationScope::InstrumentationScope(Operation operation, const Type& type, const TypeDB& typeDB, LinearAllocator& tempAllocator,
+                                           const OutputArchive& archive)
+    : InstrumentationScope { operation, type, typeDB, tempAllocator } {
+	outputArchive = &archive;
+	startBytes = archive.getBytesWritten();
+}
+
+InstrumentationScope::InstrumentationScope(Operation operation, const Type& type, const TypeDB& typeDB, LinearAllocator& tempAllocator,
+                                           const InputArchive& archive)
+    : InstrumentationScope { operation, type, typeDB, tempAllocator } {
+	inputArchive = &archive;
+	startBytes = archive.getBytesRead();
+}
+
+InstrumentationScope::InstrumentationScope(Operation operation, const Type& type, const TypeDB& typeDB, LinearAllocator& tempAllocator)
+    : counters { typeDB.getOperationCounters(type, operation) }
+    , scratchTracker { nullptr }
+    , outputArchive { nullptr }
+    , inputArchive { nullptr }
+    , startTime { Clock::now() }
+    , startBytes { 0 }
+    , startScratch { 0 }
+    , outerPeakScratch { 0 } {
+	// Scratch memory is measured only if the temporaries are allocated by the tracker of the context
+	if (ScratchTracker* tracker = getContext().scratchTracker; tracker == &tempAllocator) {
+		scratchTracker = tracker;
+		startScratch = tracker->getUsedBytes();
+		outerPeakScratch = tracker->getPeakBytes();
+		// Measure the peak of this call only
+		tracker->setPeakBytes(startScratch);
+	}
+}
+
+InstrumentationScope::~InstrumentationScope() {
+	size_t peakScratch = startScratch;
+	if (scratchTracker) {
+		peakScratch = scratchTracker->getPeakBytes();
+		scratchTracker->setPeakBytes(std::max(outerPeakScratch, peakScratch));
+	}
+	if (! counters) {
+		return;
+	}
+	const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count();
+	counters->callCount.fetch_add(1, std::memory_order_relaxed);
+	counters->nanoseconds.fetch_add(static_cast<uint64_t>(nanoseconds), std::memory_order_relaxed);
+	const size_t endBytes = getBytes();
+	counters->bytes.fetch_add(endBytes > startBytes ? endBytes - startBytes : 0, std::memory_order_relaxed);
+	const uint64_t scratch = peakScratch - startScratch;
+	uint64_t       highWater = counters->scratchHighWater.load(std::memory_order_relaxed);
+	while (scratch > highWater && ! counters->scratchHighWater.compare_exchange_weak(highWater, scratch, std::memory_order_relaxed)) {
+	}
+}
+
+size_t InstrumentationScope::getBytes() const {
+	if (outputArchive) {
+		return outputArchive->getBytesWritten();
+	}
+	return inputArchive ? inputArchive->getBytesRead() : 0;
+}
+
+} // namespace Typhoon::Reflection::detail
+
+#endif
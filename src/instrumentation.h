@@ -0,0 +1,104 @@
+#pragma once
+
+#include "config.h"
+
+#if TY_REFLECTION_INSTRUMENTATION
+
+#include "typeStats.h"
+#include <core/allocator.h>
+#include <core/uncopyable.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace Typhoon::Reflection {
+
+class InputArchive;
+class OutputArchive;
+class Type;
+class TypeDB;
+
+namespace detail {
+
+enum class Operation {
+	write,
+	read,
+	clone,
+};
+
+// Updated concurrently by the threads reading and writing archives
+struct OperationCounters {
+	std::atomic<uint64_t> callCount;
+	std::atomic<uint64_t> nanoseconds;
+	std::atomic<uint64_t> bytes;
+	std::atomic<uint64_t> scratchHighWater;
+};
+
+struct TypeCounters {
+	OperationCounters operations[3]; // indexed by Operation
+};
+
+OperationStats loadStats(const OperationCounters& counters);
+void           resetCounters(OperationCounters& counters);
+
+// Allocator for temporaries of contexts, when instrumentation is enabled. It tracks the bytes in use, so that scopes can measure
+// their peak. Rewinding to an offset or to an allocation restores the bytes in use at that point, and forgets the later allocations
+class ScratchTracker final : public LinearAllocator {
+public:
+	ScratchTracker(Allocator& parentAllocator, size_t pageSize);
+
+	using Allocator::alloc;
+
+	void*  alloc(size_t size, size_t alignment) override;
+	void   rewind() override;
+	void   rewind(void* ptr) override;
+	void*  getOffset() const override;
+	size_t getUsedBytes() const;
+	size_t getPeakBytes() const;
+	void   setPeakBytes(size_t bytes);
+
+private:
+	// Allocation, with the offset before it
+	struct Mark {
+		void*  offset;
+		void*  ptr;
+		size_t usedBytes;
+	};
+	PagedAllocator    pagedAllocator;
+	std::vector<Mark> marks;
+	size_t            usedBytes;
+	size_t            peakBytes;
+};
+
+// Record a call on a value, from construction to destruction
+class InstrumentationScope : Uncopyable {
+public:
+	InstrumentationScope(Operation operation, const Type& type, const TypeDB& typeDB, LinearAllocator& tempAllocator,
+	                     const OutputArchive& archive);
+	InstrumentationScope(Operation operation, const Type& type, const TypeDB& typeDB, LinearAllocator& tempAllocator,
+	                     const InputArchive& archive);
+	InstrumentationScope(Operation operation, const Type& type, const TypeDB& typeDB, LinearAllocator& tempAllocator);
+	~InstrumentationScope();
+
+private:
+	size_t getBytes() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+	OperationCounters*   counters;
+	ScratchTracker*      scratchTracker; // nullptr if the temporaries are not allocated by the tracker
+	const OutputArchive* outputArchive;
+	const InputArchive*  inputArchive;
+	Clock::time_point    startTime;
+	size_t               startBytes;
+	size_t               startScratch;
+	size_t               outerPeakScratch;
+};
+
+} // namespace detail
+
+} // namespace Typhoon::Reflection
+
+#endif
@@ -94,6 +94,22 @@ bool JSONInputArchive::read(std::string_view& sv) const {
 	return false;
 }
 
+bool JSONInputArchive::canFork() const {
+	return true;
+}
+
+std::unique_ptr<InputArchive> JSONInputArchive::fork(ArchiveIterator& it, size_t firstChild) const {
+	const StackItem& top = stack.top();
+	if (! top->IsArray() || firstChild >= top->Size()) {
+		return nullptr;
+	}
+	auto archive = std::make_unique<JSONInputArchive>();
+	archive->stack.push(top);
+	archive->stack.push(&(*top)[static_cast<rapidjson::SizeType>(firstChild)]);
+	it.setIndex(firstChild);
+	return archive;
+}
+
 bool JSONInputArchive::beginElement(const char* name) const {
 	assert(! stack.empty());
 	const StackItem& top = stack.top();
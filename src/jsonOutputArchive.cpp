@@ -5,132 +5,229 @@
 #include <cassert>
 #include <fstream>
 #include <rapidjson/include/rapidjson/document.h>
+#include <rapidjson/include/rapidjson/filewritestream.h>
 #include <rapidjson/include/rapidjson/prettywriter.h>
 #include <rapidjson/include/rapidjson/rapidjson.h>
 #include <rapidjson/include/rapidjson/stringbuffer.h>
+#include <rapidjson/include/rapidjson/writer.h>
 
 using namespace rapidjson;
 
 namespace Typhoon::Reflection {
 
-JSONOutputArchive::JSONOutputArchive(bool openRoot)
+namespace {
+
+constexpr size_t fileBufferSize = 65536;
+
+} // namespace
+
+template <class Function>
+decltype(auto) JSONOutputArchive::visitWriter(Function&& function) {
+	assert(writer);
+	return std::visit(std::forward<Function>(function), *writer);
+}
+
+JSONOutputArchive::JSONOutputArchive(bool openRoot, JSONFormat format)
     : stream(std::make_unique<StringBuffer>())
-    , writer(std::make_unique<PrettyWriter<StringBuffer>>(*stream))
+    , file { nullptr }
+    , endRoot { openRoot } {
+	if (format == JSONFormat::pretty) {
+		writer = std::make_unique<Writer>(std::in_place_type<PrettyWriter<StringBuffer>>, *stream);
+	}
+	else {
+		writer = std::make_unique<Writer>(std::in_place_type<rapidjson::Writer<StringBuffer>>, *stream);
+	}
+	if (openRoot) {
+		beginObject(); // begin root
+	}
+}
+
+JSONOutputArchive::JSONOutputArchive(const char* fileName, bool openRoot, JSONFormat format)
+    : file { std::fopen(fileName, "wb") }
     , endRoot { openRoot } {
+	if (file) {
+		fileBuffer = std::make_unique<char[]>(fileBufferSize);
+		fileStream = std::make_unique<FileWriteStream>(file, fileBuffer.get(), fileBufferSize);
+		if (format == JSONFormat::pretty) {
+			writer = std::make_unique<Writer>(std::in_place_type<PrettyWriter<FileWriteStream>>, *fileStream);
+		}
+		else {
+			writer = std::make_unique<Writer>(std::in_place_type<rapidjson::Writer<FileWriteStream>>, *fileStream);
+		}
+	}
+	else {
+		// Keep the archive usable, the output is discarded
+		nullStream = std::make_unique<NullStream>();
+		writer = std::make_unique<Writer>(std::in_place_type<rapidjson::Writer<NullStream>>, *nullStream);
+	}
 	if (openRoot) {
-		writer->StartObject(); // begin root
+		beginObject(); // begin root
 	}
 }
 
-JSONOutputArchive::~JSONOutputArchive() = default;
+JSONOutputArchive::~JSONOutputArchive() {
+	closeFile();
+}
+
+bool JSONOutputArchive::isFileOpen() const {
+	return file != nullptr;
+}
+
+bool JSONOutputArchive::isValid() const {
+	return ! nullStream;
+}
+
+bool JSONOutputArchive::closeFile() {
+	if (! file) {
+		return false;
+	}
+	endRootObject();
+	fileStream->Flush();
+	bool res = std::ferror(file) == 0;
+	res &= std::fclose(file) == 0;
+	file = nullptr;
+	writer.reset();
+	fileStream.reset();
+	fileBuffer.reset();
+	return res;
+}
 
 bool JSONOutputArchive::saveToFile(const char* fileName) {
-	std::string   str = saveToString();
-	std::ofstream file(fileName);
-	if (file) {
-		file.write(str.data(), str.size());
-		file.close();
+	if (! stream) {
+		assert(false);
+		return false;
+	}
+	endRootObject();
+	std::ofstream outFile(fileName);
+	if (outFile) {
+		outFile.write(stream->GetString(), stream->GetSize());
+		outFile.close();
 		return true;
 	}
 	return false;
 }
 
 std::string JSONOutputArchive::saveToString() {
-	if (endRoot) {
-		writer->EndObject();
-		endRoot = false;
+	if (! stream) {
+		assert(false);
+		return {};
 	}
-	return stream->GetString();
+	endRootObject();
+	return { stream->GetString(), stream->GetSize() };
 }
 
 void JSONOutputArchive::setKey(const char* name) {
 	assert(name);
-	writer->Key(name);
+	visitWriter([name](auto& w) { return w.Key(name); });
 }
 
 bool JSONOutputArchive::beginObject() {
-	return writer->StartObject();
+	return visitWriter([](auto& w) { return w.StartObject(); });
 }
 
 void JSONOutputArchive::endObject() {
-	writer->EndObject();
+	visitWriter([](auto& w) { return w.EndObject(); });
 }
 
 bool JSONOutputArchive::beginArray() {
-	return writer->StartArray();
+	return visitWriter([](auto& w) { return w.StartArray(); });
 }
 
 void JSONOutputArchive::endArray() {
-	writer->EndArray();
+	visitWriter([](auto& w) { return w.EndArray(); });
 }
 
 void JSONOutputArchive::writeAttribute(const char* name, bool value) {
 	writeAttributeKey(name);
-	writer->Bool(value);
+	visitWriter([value](auto& w) { return w.Bool(value); });
 }
 
 void JSONOutputArchive::writeAttribute(const char* name, int value) {
 	writeAttributeKey(name);
-	writer->Int(value);
+	visitWriter([value](auto& w) { return w.Int(value); });
 }
 
 void JSONOutputArchive::writeAttribute(const char* name, unsigned int value) {
 	writeAttributeKey(name);
-	writer->Int64(value);
+	visitWriter([value](auto& w) { return w.Int64(value); });
 }
 
 void JSONOutputArchive::writeAttribute(const char* name, float value) {
 	writeAttributeKey(name);
-	writer->Double(value);
+	visitWriter([value](auto& w) { return w.Double(value); });
 }
 
 void JSONOutputArchive::writeAttribute(const char* name, double value) {
 	writeAttributeKey(name);
-	writer->Double(value);
+	visitWriter([value](auto& w) { return w.Double(value); });
 }
 
 void JSONOutputArchive::writeAttribute(const char* name, const char* str) {
 	writeAttributeKey(name);
-	writer->String(str);
+	visitWriter([str](auto& w) { return w.String(str); });
 }
 
 void JSONOutputArchive::write(bool value) {
-	writer->Bool(value);
+	visitWriter([value](auto& w) { return w.Bool(value); });
 }
 
 void JSONOutputArchive::write(int value) {
-	writer->Int(value);
+	visitWriter([value](auto& w) { return w.Int(value); });
 }
 
 void JSONOutputArchive::write(unsigned int value) {
-	writer->Uint(value);
+	visitWriter([value](auto& w) { return w.Uint(value); });
 }
 
 void JSONOutputArchive::write(int64_t value) {
-	writer->Int64(value);
+	visitWriter([value](auto& w) { return w.Int64(value); });
 }
 
 void JSONOutputArchive::write(uint64_t value) {
-	writer->Uint64(value);
+	visitWriter([value](auto& w) { return w.Uint64(value); });
 }
 
 void JSONOutputArchive::write(float value) {
-	writer->Double(value);
+	visitWriter([value](auto& w) { return w.Double(value); });
 }
 
 void JSONOutputArchive::write(double value) {
-	writer->Double(value);
+	visitWriter([value](auto& w) { return w.Double(value); });
 }
 
 void JSONOutputArchive::write(const char* str) {
-	writer->String(str);
+	visitWriter([str](auto& w) { return w.String(str); });
 }
 
 void JSONOutputArchive::write(std::string_view str) {
-	writer->String(str.data(), static_cast<rapidjson::SizeType>(str.size()));
+	visitWriter([str](auto& w) { return w.String(str.data(), static_cast<rapidjson::SizeType>(str.size())); });
 }
 
-void JSONOutputArchive::writeAttributeKey(const char* key) const {
+bool JSONOutputArchive::canCreateChunkArchive() const {
+	return true;
+}
+
+std::unique_ptr<OutputArchive> JSONOutputArchive::createChunkArchive() const {
+	return std::make_unique<JSONOutputArchive>(false, JSONFormat::compact);
+}
+
+bool JSONOutputArchive::appendChunk(std::string_view chunk) {
+	if (chunk.size() < 2 || chunk.front() != '[' || chunk.back() != ']') {
+		return false;
+	}
+	// Insert the values of the chunk array as they are, separated from the other values by a comma
+	chunk = chunk.substr(1, chunk.size() - 2);
+	if (chunk.empty()) {
+		return true;
+	}
+	return visitWriter([chunk](auto& w) { return w.RawValue(chunk.data(), chunk.size(), kArrayType); });
+}
+
+size_t JSONOutputArchive::getBytesWritten() const {
+	return stream ? stream->GetSize() : 0;
+}
+
+void JSONOutputArchive::writeAttributeKey(const char* key) {
 	char tmp[256];
 	tmp[0] = '@';
 #ifdef _MSC_VER
@@ -139,7 +236,14 @@ void JSONOutputArchive::writeAttributeKey(const char* key) const {
 	strncpy(tmp + 1, key, sizeof(tmp) - 2);
 #endif
 	tmp[sizeof(tmp) - 1] = 0; // null terminate
-	writer->Key(tmp);
+	visitWriter([&](auto& w) { return w.Key(tmp); });
+}
+
+void JSONOutputArchive::endRootObject() {
+	if (endRoot) {
+		endObject();
+		endRoot = false;
+	}
 }
 
 } // namespace Typhoon::Reflection
@@ -0,0 +1,688 @@
+#include "jsonStreamInputArchive.h"
+
+#if TY_REFLECTION_JSON
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <rapidjson/include/rapidjson/document.h>
+#include <rapidjson/include/rapidjson/error/en.h>
+#include <rapidjson/include/rapidjson/reader.h>
+#include <string>
+#include <vector>
+
+namespace Typhoon::Reflection {
+
+namespace {
+
+constexpr unsigned int parseFlags = rapidjson::kParseCommentsFlag | rapidjson::kParseTrailingCommasFlag;
+
+// rapidjson input stream over a null terminated buffer or over a file read in chunks
+class ChunkedStream {
+public:
+	using Ch = char;
+
+	void open(const char* buffer) {
+		file = nullptr;
+		base = buffer;
+		cur = buffer;
+		last = nullptr;
+		bufferOffset = 0;
+	}
+
+	bool open(const char* fileName, size_t chunkSize) {
+		file.reset(std::fopen(fileName, "rb"));
+		if (! file) {
+			return false;
+		}
+		chunk.resize(chunkSize + 1);
+		bufferOffset = 0;
+		last = nullptr;
+		refill();
+		return true;
+	}
+
+	Ch Peek() const {
+		return *cur;
+	}
+
+	Ch Take() {
+		const Ch c = *cur++;
+		if (cur == last) {
+			refill();
+		}
+		return c;
+	}
+
+	size_t Tell() const {
+		return bufferOffset + static_cast<size_t>(cur - base);
+	}
+
+	// Not used for reading
+	Ch* PutBegin() {
+		assert(false);
+		return nullptr;
+	}
+	void Put(Ch) {
+		assert(false);
+	}
+	void Flush() {
+		assert(false);
+	}
+	size_t PutEnd(Ch*) {
+		assert(false);
+		return 0;
+	}
+
+private:
+	void refill() {
+		if (last) {
+			bufferOffset += static_cast<size_t>(last - chunk.data());
+		}
+		const size_t size = std::fread(chunk.data(), 1, chunk.size() - 1, file.get());
+		chunk[size] = '\0'; // end of stream for the reader
+		base = chunk.data();
+		cur = chunk.data();
+		last = size ? chunk.data() + size : nullptr;
+	}
+
+private:
+	struct FileDeleter {
+		void operator()(FILE* f) const {
+			std::fclose(f);
+		}
+	};
+	std::unique_ptr<FILE, FileDeleter> file;
+	std::vector<char>                  chunk;
+	const char*                        base = nullptr;
+	const char*                        cur = nullptr;
+	const char*                        last = nullptr; // end of the chunk, nullptr when reading from a buffer
+	size_t                             bufferOffset = 0;
+};
+
+enum class TokenKind : uint8_t {
+	none,
+	value,
+	key,
+	startObject,
+	endObject,
+	startArray,
+	endArray,
+};
+
+struct Token {
+	TokenKind        kind = TokenKind::none;
+	rapidjson::Value value; // scalar value or key
+	std::string      string;
+};
+
+// Store the last token received from the reader
+class TokenHandler {
+public:
+	explicit TokenHandler(Token& token)
+	    : token { token } {
+	}
+
+	bool Null() {
+		return setValue(rapidjson::Value {});
+	}
+	bool Bool(bool b) {
+		return setValue(rapidjson::Value { b });
+	}
+	bool Int(int i) {
+		return setValue(rapidjson::Value { i });
+	}
+	bool Uint(unsigned int u) {
+		return setValue(rapidjson::Value { u });
+	}
+	bool Int64(int64_t i) {
+		return setValue(rapidjson::Value { i });
+	}
+	bool Uint64(uint64_t u) {
+		return setValue(rapidjson::Value { u });
+	}
+	bool Double(double d) {
+		return setValue(rapidjson::Value { d });
+	}
+	bool RawNumber(const char*, rapidjson::SizeType, bool) {
+		return false; // not enabled
+	}
+	bool String(const char* str, rapidjson::SizeType length, bool) {
+		return setString(TokenKind::value, str, length);
+	}
+	bool Key(const char* str, rapidjson::SizeType length, bool) {
+		return setString(TokenKind::key, str, length);
+	}
+	bool StartObject() {
+		token.kind = TokenKind::startObject;
+		return true;
+	}
+	bool EndObject(rapidjson::SizeType) {
+		token.kind = TokenKind::endObject;
+		return true;
+	}
+	bool StartArray() {
+		token.kind = TokenKind::startArray;
+		return true;
+	}
+	bool EndArray(rapidjson::SizeType) {
+		token.kind = TokenKind::endArray;
+		return true;
+	}
+
+private:
+	bool setValue(rapidjson::Value&& value) {
+		token.kind = TokenKind::value;
+		token.value = std::move(value);
+		return true;
+	}
+	bool setString(TokenKind kind, const char* str, rapidjson::SizeType length) {
+		// The reader reuses its buffer, keep a copy
+		token.kind = kind;
+		token.string.assign(str, length);
+		token.value.SetString(rapidjson::StringRef(token.string.data(), length));
+		return true;
+	}
+
+private:
+	Token& token;
+};
+
+} // namespace
+
+struct JSONStreamInputArchive::Parser {
+	static constexpr size_t chunkSize = 65536;
+
+	struct Frame {
+		enum class Kind : uint8_t {
+			scalar,
+			object,
+			array,
+			buffered,
+		};
+		Kind                    kind;
+		bool                    ended;   // object or array: its end token was parsed
+		const rapidjson::Value* value;   // scalar or buffered value
+		rapidjson::Value        members; // object: members skipped while looking for another key
+		std::string             key;     // object: key of the streamed member being iterated
+	};
+
+	Parser()
+	    : handler { token } {
+	}
+
+	void reset() {
+		frames.clear();
+		bufferedFrameCount = 0;
+		bufferPool.Clear();
+		stringPool.Clear();
+		reader.IterativeParseInit();
+		token.kind = TokenKind::none;
+		fileError = false;
+	}
+
+	// Parse the first value and make it the root
+	ParseResult start() {
+		if (next()) {
+			pushValue();
+		}
+		return getResult();
+	}
+
+	ParseResult getResult() const {
+		if (fileError) {
+			return { false, "Cannot open file", 0 };
+		}
+		if (reader.HasParseError()) {
+			return { false, rapidjson::GetParseError_En(reader.GetParseErrorCode()), static_cast<int>(reader.GetErrorOffset()) };
+		}
+		return { true, rapidjson::GetParseError_En(rapidjson::kParseErrorNone), 0 };
+	}
+
+	bool next() {
+		if (reader.HasParseError() || reader.IterativeParseComplete()) {
+			return false;
+		}
+		return reader.IterativeParseNext<parseFlags>(stream, handler);
+	}
+
+	// Push the value starting at the current token
+	void pushValue() {
+		switch (token.kind) {
+		case TokenKind::startObject:
+			frames.push_back({ Frame::Kind::object, false, nullptr, {}, {} });
+			break;
+		case TokenKind::startArray:
+			frames.push_back({ Frame::Kind::array, false, nullptr, {}, {} });
+			break;
+		default:
+			assert(token.kind == TokenKind::value);
+			frames.push_back({ Frame::Kind::scalar, true, &token.value, {}, {} });
+			break;
+		}
+	}
+
+	void pushBuffered(const rapidjson::Value& value) {
+		frames.push_back({ Frame::Kind::buffered, true, &value, {}, {} });
+	}
+
+	void pop() {
+		Frame& frame = frames.back();
+		if (! frame.ended) {
+			skipContainer();
+		}
+		// Free the buffered members when nothing points to them anymore
+		const bool freeBuffer = frame.members.IsObject() && --bufferedFrameCount == 0;
+		frames.pop_back();
+		if (freeBuffer) {
+			bufferPool.Clear();
+		}
+	}
+
+	// Skip the rest of the object or array on top
+	void skipContainer() {
+		for (int depth = 1; depth > 0 && next();) {
+			if (token.kind == TokenKind::startObject || token.kind == TokenKind::startArray) {
+				++depth;
+			}
+			else if (token.kind == TokenKind::endObject || token.kind == TokenKind::endArray) {
+				--depth;
+			}
+		}
+	}
+
+	// Find a member of the streamed object on top. name == nullptr matches any member
+	bool beginMember(const char* name) {
+		Frame& frame = frames.back();
+		assert(frame.kind == Frame::Kind::object);
+		if (frame.members.IsObject()) {
+			if (auto member = name ? frame.members.FindMember(name) : frame.members.MemberBegin(); member != frame.members.MemberEnd()) {
+				pushBuffered(member->value);
+				return true;
+			}
+		}
+		while (! frame.ended && next()) {
+			if (token.kind == TokenKind::endObject) {
+				frame.ended = true;
+				break;
+			}
+			assert(token.kind == TokenKind::key);
+			if (! name || token.string == name) {
+				if (! next()) {
+					return false;
+				}
+				pushValue();
+				return true;
+			}
+			// Out of order member, keep it for later
+			rapidjson::Value key { token.string.data(), static_cast<rapidjson::SizeType>(token.string.size()), bufferPool };
+			rapidjson::Value value;
+			if (! next() || ! bufferValue(value)) {
+				return false;
+			}
+			if (! frame.members.IsObject()) {
+				frame.members.SetObject();
+				++bufferedFrameCount;
+			}
+			frame.members.AddMember(key, value, bufferPool);
+		}
+		return false;
+	}
+
+	// Build a value from the tokens, starting at the current one
+	bool bufferValue(rapidjson::Value& value) {
+		switch (token.kind) {
+		case TokenKind::value:
+			value.CopyFrom(token.value, bufferPool, true);
+			return true;
+		case TokenKind::startObject:
+			value.SetObject();
+			while (next() && token.kind == TokenKind::key) {
+				rapidjson::Value key { token.string.data(), static_cast<rapidjson::SizeType>(token.string.size()), bufferPool };
+				rapidjson::Value member;
+				if (! next() || ! bufferValue(member)) {
+					return false;
+				}
+				value.AddMember(key, member, bufferPool);
+			}
+			return token.kind == TokenKind::endObject;
+		case TokenKind::startArray:
+			value.SetArray();
+			while (next() && token.kind != TokenKind::endArray) {
+				rapidjson::Value element;
+				if (! bufferValue(element)) {
+					return false;
+				}
+				value.PushBack(element, bufferPool);
+			}
+			return token.kind == TokenKind::endArray;
+		default:
+			return false;
+		}
+	}
+
+	// Value of the scalar or buffered value on top, nullptr for a streamed object or array
+	const rapidjson::Value* getValue() const {
+		return frames.back().value;
+	}
+
+	ChunkedStream                    stream;
+	rapidjson::Reader                reader;
+	Token                            token;
+	TokenHandler                     handler;
+	std::deque<Frame>                frames; // deque keeps the keys of outer frames in place
+	size_t                           bufferedFrameCount = 0;
+	rapidjson::MemoryPoolAllocator<> bufferPool; // members read out of order
+	rapidjson::MemoryPoolAllocator<> stringPool; // strings returned by readStable
+	bool                             fileError = false;
+};
+
+JSONStreamInputArchive::JSONStreamInputArchive()
+    : parser(std::make_unique<Parser>()) {
+}
+
+JSONStreamInputArchive::~JSONStreamInputArchive() = default;
+
+ParseResult JSONStreamInputArchive::initialize(const char* buffer) {
+	parser->reset();
+	parser->stream.open(buffer);
+	return parser->start();
+}
+
+ParseResult JSONStreamInputArchive::initializeFromFile(const char* fileName) {
+	parser->reset();
+	if (! parser->stream.open(fileName, Parser::chunkSize)) {
+		parser->fileError = true;
+		return parser->getResult();
+	}
+	return parser->start();
+}
+
+ParseResult JSONStreamInputArchive::getParseResult() const {
+	return parser->getResult();
+}
+
+bool JSONStreamInputArchive::read(bool& b) const {
+	if (auto value = parser->getValue(); value && value->IsBool()) {
+		b = value->GetBool();
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::read(int& i) const {
+	if (auto value = parser->getValue(); value && value->IsInt()) {
+		i = value->GetInt();
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::read(unsigned int& ui) const {
+	if (auto value = parser->getValue(); value && value->IsUint()) {
+		ui = value->GetUint();
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::read(int64_t& i64) const {
+	if (auto value = parser->getValue(); value && value->IsInt64()) {
+		i64 = value->GetInt64();
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::read(uint64_t& ui64) const {
+	if (auto value = parser->getValue(); value && value->IsUint64()) {
+		ui64 = value->GetUint64();
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::read(float& f) const {
+	if (auto value = parser->getValue(); value && value->IsFloat()) {
+		f = value->GetFloat();
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::read(double& d) const {
+	if (auto value = parser->getValue(); value && value->IsDouble()) {
+		d = value->GetDouble();
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::read(const char*& str) const {
+	if (auto value = parser->getValue(); value && value->IsString()) {
+		// Streamed strings are held by the token, buffered ones by the buffer pool. Both are null terminated
+		str = value->GetString();
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::read(std::string_view& sv) const {
+	if (auto value = parser->getValue(); value && value->IsString()) {
+		sv = { value->GetString(), value->GetStringLength() };
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::readStable(const char*& str) const {
+	std::string_view sv;
+	if (readStable(sv)) {
+		str = sv.data();
+		return true;
+	}
+	return false;
+}
+
+bool JSONStreamInputArchive::readStable(std::string_view& sv) const {
+	if (auto value = parser->getValue(); value && value->IsString()) {
+		const size_t length = value->GetStringLength();
+		char*        str = static_cast<char*>(parser->stringPool.Malloc(length + 1));
+		std::memcpy(str, value->GetString(), length);
+		str[length] = '\0';
+		sv = { str, length };
+		return true;
+	}
+	return false;
+}
+
+size_t JSONStreamInputArchive::getBytesRead() const {
+	return parser->stream.Tell();
+}
+
+bool JSONStreamInputArchive::beginElement(const char* name) const {
+	assert(! parser->frames.empty());
+	const Parser::Frame& top = parser->frames.back();
+	if (top.kind == Parser::Frame::Kind::object) {
+		return parser->beginMember(name);
+	}
+	if (top.kind == Parser::Frame::Kind::buffered && top.value->IsObject()) {
+		if (auto member = name ? top.value->FindMember(name) : top.value->MemberBegin(); member != top.value->MemberEnd()) {
+			parser->pushBuffered(member->value);
+			return true;
+		}
+	}
+	return false;
+}
+
+void JSONStreamInputArchive::endElement() const {
+	parser->pop();
+}
+
+bool JSONStreamInputArchive::isObject() const {
+	const Parser::Frame& top = parser->frames.back();
+	return top.kind == Parser::Frame::Kind::object || (top.value && top.value->IsObject());
+}
+
+bool JSONStreamInputArchive::isArray() const {
+	const Parser::Frame& top = parser->frames.back();
+	return top.kind == Parser::Frame::Kind::array || (top.value && top.value->IsArray());
+}
+
+ValueType JSONStreamInputArchive::getValueType() const {
+	const Parser::Frame& top = parser->frames.back();
+	if (top.kind == Parser::Frame::Kind::object) {
+		return ValueType::Object;
+	}
+	if (top.kind == Parser::Frame::Kind::array) {
+		return ValueType::Array;
+	}
+	switch (top.value->GetType()) {
+	case rapidjson::Type::kNullType:
+		return ValueType::Null;
+	case rapidjson::Type::kFalseType:
+		return ValueType::False;
+	case rapidjson::Type::kTrueType:
+		return ValueType::True;
+	case rapidjson::Type::kObjectType:
+		return ValueType::Object;
+	case rapidjson::Type::kArrayType:
+		return ValueType::Array;
+	case rapidjson::Type::kStringType:
+		return ValueType::String;
+	case rapidjson::Type::kNumberType:
+		return ValueType::Number;
+	default:
+		return ValueType::Undefined;
+	}
+}
+
+size_t JSONStreamInputArchive::getElementCount() const {
+	if (auto value = parser->getValue(); value) {
+		if (value->IsArray()) {
+			return value->Size();
+		}
+		if (value->IsObject()) {
+			return value->MemberCount();
+		}
+	}
+	return 0;
+}
+
+bool JSONStreamInputArchive::iterateChild(ArchiveIterator& it) const {
+	if (it.hasValidIndex()) {
+		parser->pop();
+	}
+	const size_t   index = it.hasValidIndex() ? it.getIndex() + 1 : 0;
+	Parser::Frame& top = parser->frames.back();
+	switch (top.kind) {
+	case Parser::Frame::Kind::object: {
+		// Members buffered by previous lookups come first
+		const size_t bufferedCount = top.members.IsObject() ? top.members.MemberCount() : 0;
+		if (index < bufferedCount) {
+			const auto member = top.members.MemberBegin() + static_cast<rapidjson::SizeType>(index);
+			it.setKey(member->name.GetString());
+			parser->pushBuffered(member->value);
+			break;
+		}
+		if (top.ended || ! parser->next() || parser->token.kind == TokenKind::endObject) {
+			top.ended = true;
+			it.reset();
+			return false;
+		}
+		// The next token replaces the key, keep it until the next member
+		top.key = parser->token.string;
+		if (! parser->next()) {
+			it.reset();
+			return false;
+		}
+		it.setKey(top.key.c_str());
+		parser->pushValue();
+		break;
+	}
+	case Parser::Frame::Kind::array:
+		if (top.ended || ! parser->next() || parser->token.kind == TokenKind::endArray) {
+			top.ended = true;
+			it.reset();
+			return false;
+		}
+		parser->pushValue();
+		break;
+	case Parser::Frame::Kind::buffered:
+		if (top.value->IsArray() && index < top.value->Size()) {
+			parser->pushBuffered((*top.value)[static_cast<rapidjson::SizeType>(index)]);
+		}
+		else if (top.value->IsObject() && index < top.value->MemberCount()) {
+			const auto member = top.value->MemberBegin() + static_cast<rapidjson::SizeType>(index);
+			it.setKey(member->name.GetString());
+			parser->pushBuffered(member->value);
+		}
+		else {
+			it.reset();
+			return false;
+		}
+		break;
+	default:
+		return false; // unsupported
+	}
+	it.setIndex(index);
+	return true;
+}
+
+// Legacy
+bool JSONStreamInputArchive::iterateChild(ArchiveIterator&, const char*) const {
+	assert(false);
+	return false;
+}
+
+bool JSONStreamInputArchive::readAttribute(const char* name, bool& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool JSONStreamInputArchive::readAttribute(const char* name, int& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool JSONStreamInputArchive::readAttribute(const char* name, unsigned int& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool JSONStreamInputArchive::readAttribute(const char* name, float& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool JSONStreamInputArchive::readAttribute(const char* name, double& value) const {
+	return readAttributeValue(name, value);
+}
+
+bool JSONStreamInputArchive::readAttribute(const char* name, const char*& str) const {
+	return readAttributeValue(name, str);
+}
+
+bool JSONStreamInputArchive::readAttribute(const char* name, std::string_view& sv) const {
+	return readAttributeValue(name, sv);
+}
+
+template <class T>
+bool JSONStreamInputArchive::readAttributeValue(const char* name, T& value) const {
+	char tmp[256];
+	tmp[0] = '@';
+#ifdef _MSC_VER
+	strncpy_s(tmp + 1, sizeof(tmp) - 1, name, sizeof(tmp) - 2);
+#else
+	strncpy(tmp + 1, name, sizeof(tmp) - 2);
+#endif
+	tmp[sizeof(tmp) - 1] = 0; // null terminate
+	bool res = false;
+	if (beginElement(tmp)) {
+		res = read(value);
+		endElement();
+	}
+	return res;
+}
+
+} // namespace Typhoon::Reflection
+
+#endif
@@ -0,0 +1,97 @@
+#include "memoryMappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Typhoon::Reflection {
+
+MemoryMappedFile::MemoryMappedFile()
+    : data { nullptr }
+    , size { 0 } {
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+	close();
+}
+
+#ifdef _WIN32
+
+bool MemoryMappedFile::open(const char* fileName) {
+	close();
+	HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+		// The view keeps the mapping alive, so both handles can be closed
+		if (HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr); mapping) {
+			data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			size = data ? static_cast<size_t>(fileSize.QuadPart) : 0;
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+	return data != nullptr;
+}
+
+void MemoryMappedFile::close() {
+	if (data) {
+		UnmapViewOfFile(data);
+		data = nullptr;
+		size = 0;
+	}
+}
+
+#else
+
+bool MemoryMappedFile::open(const char* fileName) {
+	close();
+	const int fd = ::open(fileName, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+		// The mapping stays valid after the file descriptor is closed
+		void* ptr = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (ptr != MAP_FAILED) {
+			data = ptr;
+			size = static_cast<size_t>(fileStat.st_size);
+		}
+	}
+	::close(fd);
+	return data != nullptr;
+}
+
+void MemoryMappedFile::close() {
+	if (data) {
+		munmap(const_cast<void*>(data), size);
+		data = nullptr;
+		size = 0;
+	}
+}
+
+#endif
+
+bool MemoryMappedFile::isOpen() const {
+	return data != nullptr;
+}
+
+const void* MemoryMappedFile::getData() const {
+	return data;
+}
+
+size_t MemoryMappedFile::getSize() const {
+	return size;
+}
+
+} // namespace Typhoon::Reflection
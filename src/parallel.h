@@ -0,0 +1,42 @@
+#pragma once
+
+#include "executor.h"
+#include "reflection.h"
+#include <core/uncopyable.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Typhoon::Reflection::detail {
+
+// Containers with fewer values are read and written on the calling thread
+constexpr size_t minValuesPerChunk = 256;
+// More chunks than threads balance the load when values have different sizes
+constexpr size_t chunksPerThread = 4;
+
+// Return 0 if the values are not worth splitting
+inline size_t getChunkCount(size_t valueCount, const Executor& executor) {
+	const size_t chunkCount = std::min(valueCount / minValuesPerChunk, executor.getConcurrency() * chunksPerThread);
+	return chunkCount > 1 ? chunkCount : 0;
+}
+
+// Create a context for the duration of a task, unless the thread has one already
+class ThreadContextScope : Uncopyable {
+public:
+	ThreadContextScope()
+	    : owner { ! hasThreadContext() } {
+		if (owner) {
+			initThreadContext();
+		}
+	}
+	~ThreadContextScope() {
+		if (owner) {
+			deinitThreadContext();
+		}
+	}
+
+private:
+	bool owner;
+};
+
+} // namespace Typhoon::Reflection::detail
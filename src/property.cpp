@@ -1,20 +1,33 @@
 #include "property.h"
 #include "flags.h"
 #include "type.h"
+#include <algorithm>
 #include <cassert>
+#include <core/scopedAllocator.h>
+#include <cstring>
 
 namespace Typhoon::Reflection {
 
-Property::Property(Setter&& setter_, Getter&& getter_, const char* name, const Type* valueType, Allocator& allocator)
-    : setter { std::move(setter_) }
-    , getter { std::move(getter_) }
-    , name { name }
-    , prettyName { name }
+Property::Property(Setter setter, Getter getter, const void* context_, size_t contextSize_, const char* name, const Type* valueType,
+                   ScopedAllocator& arena, size_t fieldOffset)
+    : getter { getter }
+    , setter { setter }
     , valueType { valueType }
+    , name { name }
+    , fieldOffset { fieldOffset == noFieldOffset ? noFieldOffset32 : static_cast<uint32_t>(fieldOffset) }
     , flags { Flags::all }
     , semantic { Semantic::none }
-    , attributes { stdAllocator<const Attribute*>(allocator) } {
+    , attributeCount { 0 }
+    , context {}
+    , prettyName { name }
+    , attributes { nullptr }
+    , arena { &arena } {
 	assert(valueType);
+	assert(fieldOffset == noFieldOffset || fieldOffset < noFieldOffset32);
+	assert(contextSize_ <= contextSize);
+	if (contextSize_) {
+		std::memcpy(context, context_, contextSize_);
+	}
 	// Override flags
 	if (! setter) {
 		flags &= ~Flags::readable;
@@ -48,6 +61,15 @@ Semantic Property::getSemantic() const {
 	return semantic;
 }
 
+bool Property::isField() const {
+	return fieldOffset != noFieldOffset32;
+}
+
+size_t Property::getFieldOffset() const {
+	assert(isField());
+	return fieldOffset;
+}
+
 Property& Property::setPrettyName(const char* str) {
 	assert(str);
 	prettyName = str;
@@ -66,12 +88,12 @@ Property& Property::setSemantic(Semantic value) {
 
 void Property::setValue(DataPtr self, ConstDataPtr value) const {
 	assert(setter);
-	setter(self, value);
+	setter(context, self, value);
 }
 
 void Property::getValue(ConstDataPtr self, DataPtr value) const {
 	assert(getter);
-	getter(self, value);
+	getter(context, self, value);
 }
 
 void Property::copyValue(DataPtr dstSelf, ConstDataPtr srcSelf, LinearAllocator& alloc) const {
@@ -80,20 +102,25 @@ void Property::copyValue(DataPtr dstSelf, ConstDataPtr srcSelf, LinearAllocator&
 	void* allocOffs = alloc.getOffset();
 	if (void* temporary = alloc.alloc(valueType->getSize(), valueType->getAlignment()); temporary) {
 		valueType->constructObject(temporary);
-		ConstDataPtr value = getter(srcSelf, temporary);
-		setter(dstSelf, value);
+		ConstDataPtr value = getter(context, srcSelf, temporary);
+		setter(context, dstSelf, value);
 		valueType->destructObject(temporary);
 	}
 	alloc.rewind(allocOffs);
 }
 
 Property& Property::addAttribute(const Attribute* attribute) {
-	attributes.push_back(attribute);
+	// Attributes are few and added at registration. Grow the array in the arena, the previous one is released with it
+	const Attribute** newAttributes = arena->allocArray<const Attribute*>(attributeCount + 1);
+	std::copy_n(attributes, attributeCount, newAttributes);
+	newAttributes[attributeCount] = attribute;
+	attributes = newAttributes;
+	++attributeCount;
 	return *this;
 }
 
 std::span<const Attribute* const> Property::getAttributes() const {
-	return attributes;
+	return { attributes, attributeCount };
 }
 
 } // namespace Typhoon::Reflection
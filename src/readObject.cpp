@@ -6,6 +6,8 @@
 #include "containerType.h"
 #include "enumType.h"
 #include "flags.h"
+#include "instrumentation.h"
+#include "parallel.h"
 #include "pointerType.h"
 #include "property.h"
 #include "referenceType.h"
@@ -14,9 +16,11 @@
 #include "type.h"
 #include "typeDB.h"
 #include "variant.h"
+#include <algorithm>
 #include <cassert>
 #include <core/ptrUtil.h>
 #include <core/scopedAllocator.h>
+#include <optional>
 
 namespace Typhoon::Reflection {
 
@@ -55,6 +59,50 @@ bool readData(DataPtr object, const Type& type, const InputArchive& archive, con
 	return readObjectImpl(object, type, semantic, *context.typeDB, archive, *context.pagedAllocator);
 }
 
+bool readDataParallel(DataPtr object, const Type& type, const InputArchive& archive, const Context& context, Executor& executor) {
+	assert(object);
+	// Values are split by index, after sizing the container once. Arrays of numbers are excluded, as they are read in bulk anyway
+	const ContainerType* containerType = nullptr;
+	size_t               count = 0;
+	// Arenas are not thread safe
+	if (type.getSubClass() == Type::Subclass::Container && ! type.getCustomReader() && context.typeDB->isFrozen() && ! archive.getArena()
+	    && archive.isArray()) {
+		containerType = static_cast<const ContainerType*>(&type);
+		if (! containerType->getKeyType() && containerType->isContiguous() && ! isNumberType(containerType->getValueType()->getTypeId())) {
+			count = archive.getElementCount();
+		}
+	}
+	const size_t chunkCount = getChunkCount(count, executor);
+	if (! chunkCount || ! archive.canFork()) {
+		return readData(object, type, archive, context);
+	}
+	// Values replace the content of the container, as in readContainer
+	containerType->resize(object, 0);
+	if (! containerType->resize(object, count)) {
+		return readData(object, type, archive, context);
+	}
+
+	const Type&   valueType = *containerType->getValueType();
+	DataPtr const values = containerType->getElementData(object);
+	executor.run(chunkCount, [&](size_t chunk) {
+		// Workers need their own allocator for temporaries. The forked archive is destroyed first
+		ThreadContextScope                  contextScope;
+		const Context&                      threadContext = getContext();
+		const size_t                        begin = count * chunk / chunkCount;
+		const size_t                        end = count * (chunk + 1) / chunkCount;
+		ArchiveIterator                     archiveIterator;
+		const std::unique_ptr<InputArchive> chunkArchive = archive.fork(archiveIterator, begin);
+		// The forked archive starts on the first child of the chunk and is discarded, so iteration can stop at the end of the chunk
+		bool valid = chunkArchive != nullptr;
+		for (size_t i = begin; valid; ++i) {
+			readObjectImpl(advancePointer(values, i * valueType.getSize()), valueType, Semantic::none, *threadContext.typeDB, *chunkArchive,
+			               *threadContext.pagedAllocator);
+			valid = i + 1 < end && chunkArchive->iterateChild(archiveIterator);
+		}
+	});
+	return true;
+}
+
 }
 
 std::pair<bool, size_t> readArray(DataPtr array, size_t arraySize, TypeId elementTypeId, const char* arrayName, const InputArchive& archive) {
@@ -107,6 +155,9 @@ bool readObjectImpl(const char* key, DataPtr data, const Type& type, Semantic se
 }
 
 bool readObjectImpl(DataPtr data, const Type& type, Semantic semantic, const TypeDB& typeDB, const InputArchive& archive, LinearAllocator& tempAllocator) {
+#if TY_REFLECTION_INSTRUMENTATION
+	detail::InstrumentationScope instrumentationScope { detail::Operation::read, type, typeDB, tempAllocator, archive };
+#endif
 	bool res = false;
 	if (const CustomReader& customReader = type.getCustomReader(); customReader) {
 		customReader(data, archive);
@@ -118,36 +169,68 @@ bool readObjectImpl(DataPtr data, const Type& type, Semantic semantic, const Typ
 	return res;
 }
 
-void readStructProperties(DataPtr data, const StructType& type, const TypeDB& typeDB, const InputArchive& archive, LinearAllocator& tempAllocator) {
-	for (const auto& property : type.getProperties()) {
-		if (property.getFlags() & Flags::readable) {
-			if (archive.beginElement(property.getName())) {
-				const Type& valueType = property.getValueType();
-				void*       allocOffs = tempAllocator.getOffset();
-				// Allocate a temporary for the value
-				if (void* temporary = tempAllocator.alloc(valueType.getSize(), valueType.getAlignment()); temporary) {
-					valueType.constructObject(temporary);
-					const DataPtr self = data;
-					// First set temporary value using getter as readObject might fail or partly fill the data
-					property.getValue(self, temporary);
-					readObjectImpl(temporary, valueType, property.getSemantic(), typeDB, archive, tempAllocator);
-					property.setValue(self, temporary);
-					valueType.destructObject(temporary);
-				}
-				tempAllocator.rewind(allocOffs);
-				archive.endElement();
-			}
+bool readProperty(const PropertyOp& op, DataPtr value, const TypeDB& typeDB, const InputArchive& archive, LinearAllocator& tempAllocator) {
+#if TY_REFLECTION_INSTRUMENTATION
+	detail::InstrumentationScope instrumentationScope { detail::Operation::read, *op.valueType, typeDB, tempAllocator, archive };
+#endif
+	switch (op.code) {
+	case PropertyOp::Code::custom:
+		op.valueType->getCustomReader()(value, archive);
+		return true;
+	case PropertyOp::Code::structure:
+		return readStruct(value, *op.valueType, op.property->getSemantic(), typeDB, archive, tempAllocator);
+	case PropertyOp::Code::generic:
+		return perClassReaders[(int)op.valueType->getSubClass()](value, *op.valueType, op.property->getSemantic(), typeDB, archive, tempAllocator);
+	}
+	return false;
+}
+
+void readStructProperty(const PropertyOp& op, DataPtr self, const TypeDB& typeDB, const InputArchive& archive, LinearAllocator& tempAllocator) {
+	if (op.fieldOffset != Property::noFieldOffset) {
+		// Plain data member, read it in place
+		readProperty(op, advancePointer(self, op.fieldOffset), typeDB, archive, tempAllocator);
+	}
+	else {
+		const Type& valueType = *op.valueType;
+		void*       allocOffs = tempAllocator.getOffset();
+		// Allocate a temporary for the value
+		if (void* temporary = tempAllocator.alloc(valueType.getSize(), valueType.getAlignment()); temporary) {
+			valueType.constructObject(temporary);
+			// First set temporary value using getter as readObject might fail or partly fill the data
+			op.property->getValue(self, temporary);
+			readProperty(op, temporary, typeDB, archive, tempAllocator);
+			op.property->setValue(self, temporary);
+			valueType.destructObject(temporary);
 		}
+		tempAllocator.rewind(allocOffs);
 	}
 }
 
 bool readStruct(DataPtr data, const Type& type, [[maybe_unused]] Semantic semantic, const TypeDB& typeDB, const InputArchive& archive,
                 LinearAllocator& tempAllocator) {
-	const StructType* structType = static_cast<const StructType*>(&type);
-	do {
-		readStructProperties(data, *structType, typeDB, archive, tempAllocator);
-		structType = structType->getParentType();
-	} while (structType);
+	const StructType&                 structType = static_cast<const StructType&>(type);
+	const std::span<const PropertyOp> readPlan = structType.getReadPlan();
+	// Visit the members of the archive once, instead of searching each property. Members usually follow the plan order, so check
+	// the property after the last one read before hashing the key. Hidden properties are never matched by name
+	size_t          nextOp = 0;
+	ArchiveIterator it;
+	while (archive.iterateChild(it)) {
+		const char* key = it.getKey();
+		if (! key) {
+			continue;
+		}
+		const PropertyOp* op = nullptr;
+		if (nextOp < readPlan.size() && ! readPlan[nextOp].hidden && ! strcmp(readPlan[nextOp].property->getName(), key)) {
+			op = &readPlan[nextOp];
+		}
+		else {
+			op = structType.findReadOp(key);
+		}
+		if (op) {
+			readStructProperty(*op, data, typeDB, archive, tempAllocator);
+			nextOp = static_cast<size_t>(op - readPlan.data()) + 1;
+		}
+	}
 	return true;
 }
 
@@ -174,12 +257,17 @@ bool readBitMask(DataPtr dstData, const Type& type, Semantic /*semantic*/, const
 	const BitMaskType& bitMaskType = static_cast<const BitMaskType&>(type);
 	assert(bitMaskType.getSize() <= sizeof(BitMaskStorageType));
 	bool res = false;
-	if (const char* maskStr = nullptr; archive.read(maskStr)) {
+	if (std::string_view maskStr; archive.read(maskStr)) {
+		// Constants are separated by |. Unknown names are ignored
 		BitMaskStorageType bitMask = 0;
-		for (const BitMaskConstant& enumerator : bitMaskType.getEnumerators()) {
-			if (strstr(maskStr, enumerator.name)) {
-				bitMask |= enumerator.mask;
-			}
+		while (! maskStr.empty()) {
+			const size_t     separator = maskStr.find('|');
+			std::string_view token = maskStr.substr(0, separator);
+			maskStr = separator == std::string_view::npos ? std::string_view {} : maskStr.substr(separator + 1);
+			// Trim spaces
+			token.remove_prefix(std::min(token.find_first_not_of(' '), token.size()));
+			token.remove_suffix(token.size() - std::min(token.find_last_not_of(' ') + 1, token.size()));
+			bitMask |= bitMaskType.findConstantByName(token);
 		}
 		// (Narrow) cast bitMask to the destination data
 		std::memcpy(dstData, &bitMask, type.getSize());
@@ -193,9 +281,52 @@ bool readContainer(DataPtr data, const Type& type, Semantic semantic, const Type
 	const Type*          key_type = containerType.getKeyType();
 	const Type*          value_type = containerType.getValueType();
 
+	std::optional<detail::ArenaSuspension> arenaSuspension;
+	if (std::pmr::memory_resource* arena = archive.getArena(); arena) {
+		// Values replace the content of contiguous containers, so they can be emptied and rebound
+		if (containerType.isContiguous()) {
+			containerType.resize(data, 0);
+		}
+		if (! containerType.bindArena(data, *arena)) {
+			// The values share the resource of the container
+			arenaSuspension.emplace(archive);
+		}
+	}
+
+	if (! key_type && containerType.isContiguous() && detail::isNumberType(value_type->getTypeId())) {
+		// Numbers are read in bulk, after sizing the container once
+		const size_t valueSize = value_type->getSize();
+		if (std::span<const std::byte> blob; archive.readBlob(blob)) {
+			const size_t count = blob.size() / valueSize;
+			if (value_type->getTypeId() == getTypeId<bool>()
+			    && std::any_of(blob.begin(), blob.end(), [](std::byte b) { return b != std::byte { 0 } && b != std::byte { 1 }; })) {
+				// Copying other bytes would create invalid bools
+				return false;
+			}
+			if (blob.size() % valueSize != 0 || ! containerType.resize(data, count)) {
+				return false;
+			}
+			if (count) {
+				std::memcpy(containerType.getElementData(data), blob.data(), blob.size());
+			}
+			return true;
+		}
+		// Archives that cannot count elements in advance return 0, in which case the loop below fills the emptied container
+		if (const size_t count = archive.getElementCount(); containerType.resize(data, count) && count) {
+			return detail::readNumbers(containerType.getElementData(data), count, value_type->getTypeId(), archive);
+		}
+	}
+
+	if (containerType.isContiguous()) {
+		// Values replace the content of the container. Fixed size arrays ignore this
+		containerType.resize(data, 0);
+	}
+
 	ScopedAllocator      outerScopedAllocator(tempAllocator);
 	WriteIterator* const containerIterator = containerType.newWriteIterator(data, outerScopedAllocator);
 	ArchiveIterator      archiveIterator;
+	// Allocate storage once. Streaming archives do not know the count in advance and return 0
+	containerIterator->reserve(archive.getElementCount());
 	while (archive.iterateChild(archiveIterator)) {
 		if (containerIterator->isValid()) {
 			if (key_type) {
@@ -244,12 +375,12 @@ bool readReference(DataPtr data, const Type& type, Semantic semantic, const Type
 bool readVariant(DataPtr data, const Type& /*type*/, Semantic semantic, const TypeDB& typeDB, const InputArchive& archive, LinearAllocator& tempAllocator) {
 	bool res = false;
 	if (archive.isObject()) {
-		const char* typeName = nullptr;
+		std::string_view typeName;
 		if (! archive.read("type", typeName)) {
 			return false;
 		}
 
-		const Type* type = typeDB.tryGetType(typeName);
+		const Type* type = typeDB.tryGetType(typeName, hashString(typeName));
 		if (! type) {
 			return false;
 		}
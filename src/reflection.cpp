@@ -1,7 +1,9 @@
 #include "reflection.h"
 #include "archive.h"
+#include "arenaResource.h"
 #include "builtinType.h"
 #include "context.h"
+#include "instrumentation.h"
 #include "serializeBuiltIns.h"
 #include "variantType.h"
 #include <core/scopedAllocator.h>
@@ -37,9 +39,30 @@ void writeBuiltin<std::string>(ConstDataPtr data, OutputArchive& archive) {
 	archive.write(std::string_view { *cast<std::string>(data) });
 }
 
+template <>
+bool readBuiltin<std::pmr::string>(DataPtr data, const InputArchive& archive) {
+	std::string_view str;
+	if (archive.read(str)) {
+		std::pmr::string& dst = *cast<std::pmr::string>(data);
+		if (std::pmr::memory_resource* arena = archive.getArena(); arena) {
+			dst.clear();
+			detail::bindArena(dst, *arena);
+		}
+		dst.assign(str);
+		return true;
+	}
+	return false;
+}
+
+template <>
+void writeBuiltin<std::pmr::string>(ConstDataPtr data, OutputArchive& archive) {
+	archive.write(std::string_view { *cast<std::pmr::string>(data) });
+}
+
 template <>
 bool readBuiltin<std::string_view>(DataPtr data, const InputArchive& archive) {
-	return archive.read(*cast<std::string_view>(data));
+	// The object keeps the view
+	return archive.readStable(*cast<std::string_view>(data));
 }
 
 template <>
@@ -76,14 +99,26 @@ void registerBuiltinTypes(Context& context) {
 	CREATE_BUILTIN(const char*, context);
 	CREATE_BUILTIN(std::string, context);
 	CREATE_BUILTIN(std::string_view, context);
+	CREATE_BUILTIN(std::pmr::string, context);
 
 	auto variantType = context.scopedAllocator->make<VariantType>(*context.allocator);
 	context.typeDB->registerType(variantType);
 	context.typeDB->getGlobalNamespace().addType(variantType);
 }
 
+void createTempAllocator(Context& context) {
+#if TY_REFLECTION_INSTRUMENTATION
+	context.scratchTracker = context.allocator->construct<detail::ScratchTracker>(*context.allocator, PagedAllocator::defaultPageSize);
+	context.pagedAllocator = context.scratchTracker;
+#else
+	context.pagedAllocator = context.allocator->construct<PagedAllocator>(*context.allocator, PagedAllocator::defaultPageSize);
+#endif
+}
+
 HeapAllocator defaultAllocator;
 Context       defaultContext {};
+// Set by initThreadContext, shares the type registry of defaultContext
+thread_local Context threadContext {};
 
 } // namespace
 
@@ -96,7 +131,7 @@ void initReflection(Allocator& allocator) {
 	assert(! context.typeDB);
 
 	context.allocator = &allocator;
-	context.pagedAllocator = allocator.construct<PagedAllocator>(allocator, PagedAllocator::defaultPageSize);
+	createTempAllocator(context);
 	context.scopedAllocator = allocator.construct<ScopedAllocator>(*context.pagedAllocator);
 	context.typeDB = context.scopedAllocator->make<TypeDB>(allocator, *context.scopedAllocator);
 	registerBuiltinTypes(context);
@@ -112,6 +147,39 @@ void deinitReflection() {
 	context.allocator = nullptr;
 }
 
+bool freezeReflection() {
+	assert(defaultContext.typeDB);
+	return defaultContext.typeDB->freeze();
+}
+
+void initThreadContext() {
+	initThreadContext(defaultAllocator);
+}
+
+void initThreadContext(Allocator& allocator) {
+	auto& context = threadContext;
+	assert(! context.typeDB);
+	// Threads only read the registry
+	assert(defaultContext.typeDB && defaultContext.typeDB->isFrozen());
+
+	context.allocator = &allocator;
+	createTempAllocator(context);
+	context.scopedAllocator = allocator.construct<ScopedAllocator>(*context.pagedAllocator);
+	context.typeDB = defaultContext.typeDB;
+}
+
+void deinitThreadContext() {
+	auto& context = threadContext;
+	assert(context.scopedAllocator);
+	context.allocator->destroy(context.scopedAllocator);
+	context.allocator->destroy(context.pagedAllocator);
+	context = {};
+}
+
+bool hasThreadContext() {
+	return threadContext.typeDB != nullptr;
+}
+
 bool isInitialized() {
 	return defaultContext.allocator != nullptr;
 }
@@ -131,6 +199,9 @@ const Namespace& getGlobalNamespace() {
 namespace detail {
 
 Context& getContext() {
+	if (threadContext.typeDB) {
+		return threadContext;
+	}
 	assert(defaultContext.typeDB);
 	return defaultContext;
 }
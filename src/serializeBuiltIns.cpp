@@ -122,7 +122,8 @@ bool read(double& data, const InputArchive& archive) {
 }
 
 bool read(const char*& data, const InputArchive& archive) {
-	return archive.read(data);
+	// The object keeps the string
+	return archive.readStable(data);
 }
 
 void write(bool data, OutputArchive& archive) {
@@ -198,4 +199,87 @@ void write(const char* str, OutputArchive& archive) {
 	archive.write(str);
 }
 
+namespace {
+
+template <class T>
+void writeValues(const void* values, size_t count, OutputArchive& archive) {
+	for (const T *value = static_cast<const T*>(values), *end = value + count; value != end; ++value) {
+		write(*value, archive);
+	}
+}
+
+template <class T>
+void readValues(void* values, size_t count, const InputArchive& archive) {
+	T* const        dst = static_cast<T*>(values);
+	ArchiveIterator it;
+	// Iterate all children, even the ones that do not fit, to leave the archive in a consistent state
+	for (size_t i = 0; archive.iterateChild(it); ++i) {
+		if (i < count) {
+			read(dst[i], archive);
+		}
+	}
+}
+
+struct NumberArraySerializer {
+	TypeId typeId;
+	void (*writeValues)(const void* values, size_t count, OutputArchive& archive);
+	void (*readValues)(void* values, size_t count, const InputArchive& archive);
+};
+
+template <class T>
+constexpr NumberArraySerializer makeNumberArraySerializer() {
+	return { getTypeId<T>(), writeValues<T>, readValues<T> };
+}
+
+constexpr NumberArraySerializer numberArraySerializers[] = {
+	makeNumberArraySerializer<bool>(),
+	makeNumberArraySerializer<char>(),
+	makeNumberArraySerializer<unsigned char>(),
+	makeNumberArraySerializer<short>(),
+	makeNumberArraySerializer<unsigned short>(),
+	makeNumberArraySerializer<int>(),
+	makeNumberArraySerializer<unsigned int>(),
+	makeNumberArraySerializer<long>(),
+	makeNumberArraySerializer<unsigned long>(),
+	makeNumberArraySerializer<long long>(),
+	makeNumberArraySerializer<unsigned long long>(),
+	makeNumberArraySerializer<float>(),
+	makeNumberArraySerializer<double>(),
+};
+
+const NumberArraySerializer* findNumberArraySerializer(TypeId typeId) {
+	for (const NumberArraySerializer& serializer : numberArraySerializers) {
+		if (serializer.typeId == typeId) {
+			return &serializer;
+		}
+	}
+	return nullptr;
+}
+
+} // namespace
+
+namespace detail {
+
+bool isNumberType(TypeId typeId) {
+	return findNumberArraySerializer(typeId) != nullptr;
+}
+
+bool writeNumbers(const void* values, size_t count, TypeId typeId, OutputArchive& archive) {
+	if (const NumberArraySerializer* serializer = findNumberArraySerializer(typeId); serializer) {
+		serializer->writeValues(values, count, archive);
+		return true;
+	}
+	return false;
+}
+
+bool readNumbers(void* values, size_t count, TypeId typeId, const InputArchive& archive) {
+	if (const NumberArraySerializer* serializer = findNumberArraySerializer(typeId); serializer) {
+		serializer->readValues(values, count, archive);
+		return true;
+	}
+	return false;
+}
+
+} // namespace detail
+
 } // namespace Typhoon::Reflection
@@ -0,0 +1,60 @@
+#include "stringTable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace Typhoon::Reflection::detail {
+
+StringTable::StringTable(Allocator& allocator)
+    : allocator { allocator }
+    , index { allocator }
+    , strings { stdAllocator<const char*>(allocator) }
+    , pages { stdAllocator<Page>(allocator) }
+    , pageOffset { pageSize } {
+}
+
+StringTable::~StringTable() {
+	for (const Page& page : pages) {
+		allocator.free(page.buffer, page.size);
+	}
+}
+
+const char* StringTable::intern(std::string_view str) {
+	const uint64_t hash = hashString(str);
+	{
+		std::shared_lock<std::shared_mutex> lock { mutex };
+		if (const uint32_t i = find(hash, str); i != HashIndex::invalidValue) {
+			return strings[i];
+		}
+	}
+	std::unique_lock<std::shared_mutex> lock { mutex };
+	// Another thread may have added the string meanwhile
+	if (const uint32_t i = find(hash, str); i != HashIndex::invalidValue) {
+		return strings[i];
+	}
+	char* copy = allocString(str.size() + 1);
+	std::memcpy(copy, str.data(), str.size());
+	copy[str.size()] = 0;
+	index.insert(hash, static_cast<uint32_t>(strings.size()));
+	strings.push_back(copy);
+	return copy;
+}
+
+char* StringTable::allocString(size_t size) {
+	if (size > pageSize - pageOffset) {
+		const size_t bufferSize = std::max(size, pageSize);
+		pages.push_back({ static_cast<char*>(allocator.alloc(bufferSize, alignof(char))), bufferSize });
+		pageOffset = 0;
+	}
+	char* str = pages.back().buffer + pageOffset;
+	// Pages of strings longer than pageSize are full
+	pageOffset = std::min(pageOffset + size, pageSize);
+	return str;
+}
+
+uint32_t StringTable::find(uint64_t hash, std::string_view str) const {
+	return index.find(hash, [this, str](uint32_t s) { return str == strings[s]; });
+}
+
+} // namespace Typhoon::Reflection::detail
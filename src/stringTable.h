@@ -0,0 +1,42 @@
+#pragma once
+
+#include "hash.h"
+#include <core/allocator.h>
+#include <core/stdAllocator.h>
+#include <core/uncopyable.h>
+
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+namespace Typhoon::Reflection::detail {
+
+// Strings shared by all the threads, freed when the table is destroyed. Lookups of strings already in the table only take a
+// shared lock
+class StringTable : Uncopyable {
+public:
+	explicit StringTable(Allocator& allocator);
+	~StringTable();
+
+	// Return a null terminated copy of str, the same for all equal strings
+	const char* intern(std::string_view str);
+
+private:
+	char*    allocString(size_t size);
+	uint32_t find(uint64_t hash, std::string_view str) const;
+
+private:
+	struct Page {
+		char*  buffer;
+		size_t size;
+	};
+	static constexpr size_t                             pageSize = 4096;
+	Allocator&                                          allocator;
+	std::shared_mutex                                   mutex;
+	HashIndex                                           index;
+	std::vector<const char*, stdAllocator<const char*>> strings;
+	std::vector<Page, stdAllocator<Page>>               pages;
+	size_t                                              pageOffset;
+};
+
+} // namespace Typhoon::Reflection::detail
@@ -1,15 +1,26 @@
 #include "structType.h"
 #include "attribute.h"
+#include "flags.h"
 #include "property.h"
 #include <core/allocator.h>
 
+#include <algorithm>
+
 namespace Typhoon::Reflection {
 
 StructType::StructType(const char* typeName, TypeId typeID, size_t size, size_t alignment, const StructType* parentType, const MethodTable& methods,
                        Allocator& allocator)
     : Type { typeName, typeID, Subclass::Struct, size, alignment, methods, allocator }
     , parentType(parentType)
-    , properties(stdAllocator<Property>(allocator)) {
+    , properties(stdAllocator<Property>(allocator))
+    , readPlan(stdAllocator<PropertyOp>(allocator))
+    , writePlan(stdAllocator<PropertyOp>(allocator))
+    , flatProperties(stdAllocator<const Property*>(allocator))
+    , propertyIndex(allocator)
+    , readPlanIndex(allocator)
+    , cloneRanges(stdAllocator<ByteRange>(allocator))
+    , clonedByCopy(false)
+    , plansCompiled(false) {
 }
 
 StructType::~StructType() = default;
@@ -30,6 +41,7 @@ bool StructType::inheritsFrom(const StructType* type) const {
 }
 
 Property& StructType::addProperty(Property&& property) {
+	assert(! plansCompiled);
 	properties.push_back(std::move(property));
 	return properties.back();
 }
@@ -38,14 +50,162 @@ std::span<const Property> StructType::getProperties() const {
 	return properties;
 }
 
+std::span<const Property* const> StructType::getAllProperties() const {
+	if (! plansCompiled) {
+		compilePlans();
+	}
+	return flatProperties;
+}
+
 const Property* StructType::getProperty(const char* propertyName) const {
 	assert(propertyName);
-	for (const auto& p : properties) {
-		if (! strcmp(p.getName(), propertyName)) {
-			return &p;
+	if (! plansCompiled) {
+		// The type is still being built, don't compile it
+		for (const auto& p : properties) {
+			if (! strcmp(p.getName(), propertyName)) {
+				return &p;
+			}
 		}
+		return nullptr;
+	}
+	// Own properties come first in the flattened list
+	const Property* property = findProperty(propertyName);
+	return property && property >= properties.data() && property < properties.data() + properties.size() ? property : nullptr;
+}
+
+const Property* StructType::findProperty(std::string_view propertyName) const {
+	return findProperty(propertyName, hashString(propertyName));
+}
+
+const Property* StructType::findProperty(std::string_view propertyName, uint64_t nameHash) const {
+	assert(nameHash == hashString(propertyName));
+	if (! plansCompiled) {
+		compilePlans();
+	}
+	if (frozenProperties.isValid()) {
+		const uint32_t index = frozenProperties.find(nameHash);
+		return index != detail::PerfectHashTable::invalidValue && flatProperties[index]->getName() == propertyName ? flatProperties[index] : nullptr;
+	}
+	const uint32_t index =
+	    propertyIndex.find(nameHash, [this, propertyName](uint32_t i) { return flatProperties[i]->getName() == propertyName; });
+	return index != detail::HashIndex::invalidValue ? flatProperties[index] : nullptr;
+}
+
+std::span<const PropertyOp> StructType::getReadPlan() const {
+	if (! plansCompiled) {
+		compilePlans();
+	}
+	return readPlan;
+}
+
+std::span<const PropertyOp> StructType::getWritePlan() const {
+	if (! plansCompiled) {
+		compilePlans();
+	}
+	return writePlan;
+}
+
+const PropertyOp* StructType::findReadOp(std::string_view propertyName) const {
+	if (! plansCompiled) {
+		compilePlans();
+	}
+	const uint32_t index =
+	    readPlanIndex.find(hashString(propertyName), [this, propertyName](uint32_t i) { return readPlan[i].property->getName() == propertyName; });
+	return index != detail::HashIndex::invalidValue ? &readPlan[index] : nullptr;
+}
+
+bool StructType::isClonedByCopy() const {
+	if (! plansCompiled) {
+		compilePlans();
+	}
+	return clonedByCopy;
+}
+
+std::span<const ByteRange> StructType::getCloneRanges() const {
+	if (! plansCompiled) {
+		compilePlans();
+	}
+	return cloneRanges;
+}
+
+bool StructType::isMemoryCopyable() const {
+	if (! plansCompiled) {
+		compilePlans();
+	}
+	return clonedByCopy && isTriviallyCopyable() && cloneRanges.size() == 1 && cloneRanges[0].offset == 0 && cloneRanges[0].size == getSize();
+}
+
+void StructType::compilePlans() const {
+	auto getCode = [](const Type& valueType, bool hasCustomOp) {
+		if (hasCustomOp) {
+			return PropertyOp::Code::custom;
+		}
+		return valueType.getSubClass() == Subclass::Struct ? PropertyOp::Code::structure : PropertyOp::Code::generic;
+	};
+
+	readPlan.clear();
+	writePlan.clear();
+	flatProperties.clear();
+	propertyIndex.clear();
+	readPlanIndex.clear();
+	cloneRanges.clear();
+	clonedByCopy = true;
+	for (const StructType* structType = this; structType; structType = structType->parentType) {
+		for (const Property& property : structType->properties) {
+			const std::string_view name = property.getName();
+			const uint64_t         hash = hashString(name);
+			auto                   sameName = [this, name](uint32_t i) { return flatProperties[i]->getName() == name; };
+			const bool             hidden = propertyIndex.find(hash, sameName) != detail::HashIndex::invalidValue;
+			if (! hidden) {
+				propertyIndex.insert(hash, static_cast<uint32_t>(flatProperties.size()));
+			}
+			flatProperties.push_back(&property);
+			const Type&  valueType = property.getValueType();
+			const size_t fieldOffset = property.isField() ? property.getFieldOffset() : Property::noFieldOffset;
+			if (property.getFlags() & Flags::readable) {
+				if (! hidden) {
+					readPlanIndex.insert(hash, static_cast<uint32_t>(readPlan.size()));
+				}
+				readPlan.push_back(
+				    { getCode(valueType, static_cast<bool>(valueType.getCustomReader())), &property, &valueType, fieldOffset, hidden });
+			}
+			if (property.getFlags() & Flags::writeable) {
+				writePlan.push_back(
+				    { getCode(valueType, static_cast<bool>(valueType.getCustomWriter())), &property, &valueType, fieldOffset, hidden });
+			}
+			if (property.getFlags() & Flags::clonable) {
+				// Fields are cloned by copy assignment, which for these types copies bytes
+				const Subclass subclass = valueType.getSubClass();
+				const bool     isPlainValue = subclass == Subclass::Builtin || subclass == Subclass::Struct || subclass == Subclass::Enum
+				                          || subclass == Subclass::BitMask;
+				if (property.isField() && valueType.isTriviallyCopyable() && isPlainValue) {
+					cloneRanges.push_back({ fieldOffset, valueType.getSize() });
+				}
+				else {
+					clonedByCopy = false;
+				}
+			}
+		}
+	}
+	if (clonedByCopy) {
+		// Merge adjacent fields, so that dense structs are copied at once
+		std::sort(cloneRanges.begin(), cloneRanges.end(), [](const ByteRange& a, const ByteRange& b) { return a.offset < b.offset; });
+		size_t count = 0;
+		for (const ByteRange& range : cloneRanges) {
+			if (count && range.offset <= cloneRanges[count - 1].offset + cloneRanges[count - 1].size) {
+				ByteRange& last = cloneRanges[count - 1];
+				last.size = std::max(last.size, range.offset + range.size - last.offset);
+			}
+			else {
+				cloneRanges[count++] = range;
+			}
+		}
+		cloneRanges.resize(count);
+	}
+	else {
+		cloneRanges.clear();
 	}
-	return nullptr;
+	plansCompiled = true;
 }
 
 } // namespace Typhoon::Reflection
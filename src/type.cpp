@@ -72,6 +72,10 @@ bool Type::compareObjects(ConstDataPtr a, ConstDataPtr b) const {
 	return methods.equalityOperator(a, b);
 }
 
+bool Type::isTriviallyCopyable() const {
+	return methods.triviallyCopyable;
+}
+
 void Type::setCustomWriter(CustomWriter writer) {
 	customWriter = std::move(writer);
 }
@@ -1,9 +1,17 @@
 #include "typeDB.h"
+#include "enumType.h"
+#include "instrumentation.h"
 #include "namespace.h"
+#include "property.h"
+#include "stringTable.h"
 #include "structType.h"
 #include <core/scopedAllocator.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 namespace Typhoon::Reflection {
@@ -26,16 +34,161 @@ const char* decorateTypeName(std::string_view typeName, std::string_view prefix,
 	return str;
 }
 
+void registerRequiredType(TypeDB& typeDB, const Type* type) {
+	if (! typeDB.registerType(type)) {
+		std::abort(); // the registry is frozen, carrying on would leave callers with a missing type
+	}
+}
+
 } // namespace detail
 
+namespace {
+
+using FrozenEntry = detail::PerfectHashTable::Entry;
+using FrozenEntryVector = std::vector<FrozenEntry, stdAllocator<FrozenEntry>>;
+
+template <class T, class GetName>
+void collectNames(std::span<const T> items, GetName&& getName, FrozenEntryVector& entries) {
+	entries.clear();
+	for (size_t i = 0; i < items.size(); ++i) {
+		const char*    name = getName(items[i]);
+		const uint64_t hash = hashString(name);
+		// Keep the first of duplicated names, as linear searches did
+		if (std::none_of(entries.begin(), entries.end(),
+		                 [&](const FrozenEntry& e) { return e.hash == hash && ! strcmp(getName(items[e.value]), name); })) {
+			entries.push_back({ hash, static_cast<uint32_t>(i) });
+		}
+	}
+}
+
+void collectMemberNames(const Type& type, FrozenEntryVector& entries) {
+	entries.clear();
+	if (type.getSubClass() == Type::Subclass::Struct) {
+		// Index inherited properties too, as StructType::findProperty does
+		collectNames(static_cast<const StructType&>(type).getAllProperties(), [](const Property* p) { return p->getName(); }, entries);
+	}
+	else if (type.getSubClass() == Type::Subclass::Enum) {
+		collectNames(static_cast<const EnumType&>(type).getEnumerators(), [](const Enumerator& e) { return e.name; }, entries);
+	}
+}
+
+size_t getFrozenStorageSize(size_t entryCount) {
+	// Keep each table aligned
+	return (detail::PerfectHashTable::getStorageSize(entryCount) + alignof(FrozenEntry) - 1) & ~(alignof(FrozenEntry) - 1);
+}
+
+} // namespace
+
 TypeDB::TypeDB(Allocator& allocator, ScopedAllocator& scopedAllocator)
-    : types { stdAllocator<const Type*>(allocator) }
-    , globalNamespace { scopedAllocator.make<Namespace>(nullptr, allocator) } {
+    : allocator { allocator }
+    , scopedAllocator { scopedAllocator }
+    , types { stdAllocator<const Type*>(allocator) }
+    , typeIdIndex { allocator }
+    , typeNameIndex { allocator }
+    , globalNamespace { scopedAllocator.make<Namespace>(nullptr, allocator) }
+    , stringTable { scopedAllocator.make<detail::StringTable>(allocator) }
+    , frozenStorage { nullptr }
+    , frozenStorageSize { 0 }
+#if TY_REFLECTION_INSTRUMENTATION
+    , typeCounters { stdAllocator<detail::TypeCounters*>(allocator) }
+#endif
+    , frozen { false } {
+}
+
+TypeDB::~TypeDB() {
+	if (frozenStorage) {
+		allocator.free(frozenStorage, frozenStorageSize);
+	}
 }
 
-void TypeDB::registerType(const Type* newType) {
+bool TypeDB::registerType(const Type* newType) {
 	assert(newType);
+	if (frozen) {
+		// The registry is read-only once frozen
+		return false;
+	}
+	const TypeId typeID = newType->getTypeId();
+#if TY_REFLECTION_INSTRUMENTATION
+	typeCounters.push_back(scopedAllocator.make<detail::TypeCounters>());
+#endif
+	if (tryGetType(typeID)) {
+		// Keep the first registration, as lookups did before indexing
+		types.push_back(newType);
+		return true;
+	}
+	if (newType->getSubClass() == Type::Subclass::Struct) {
+		// Properties are final once the type is registered
+		static_cast<const StructType*>(newType)->compilePlans();
+	}
+	const uint32_t index = static_cast<uint32_t>(types.size());
+	typeIdIndex.insert(detail::hashPointer(typeID.impl), index);
+	if (const char* typeName = newType->getName(); typeName && ! tryGetType(typeName)) {
+		typeNameIndex.insert(hashString(typeName), index);
+	}
 	types.push_back(newType);
+	return true;
+}
+
+bool TypeDB::freeze() {
+	if (frozen) {
+		return true;
+	}
+
+	// Only index what the dynamic indices can reach, so that lookups return the same results once frozen
+	FrozenEntryVector typeIdEntries { stdAllocator<FrozenEntry>(allocator) };
+	FrozenEntryVector typeNameEntries { stdAllocator<FrozenEntry>(allocator) };
+	FrozenEntryVector memberEntries { stdAllocator<FrozenEntry>(allocator) };
+	size_t            storageSize = 0;
+	for (size_t i = 0; i < types.size(); ++i) {
+		const Type* type = types[i];
+		if (tryGetType(type->getTypeId()) != type) {
+			continue;
+		}
+		typeIdEntries.push_back({ detail::hashPointer(type->getTypeId().impl), static_cast<uint32_t>(i) });
+		if (const char* typeName = type->getName(); typeName && tryGetType(typeName) == type) {
+			typeNameEntries.push_back({ hashString(typeName), static_cast<uint32_t>(i) });
+		}
+		collectMemberNames(*type, memberEntries);
+		if (! memberEntries.empty()) {
+			storageSize += getFrozenStorageSize(memberEntries.size());
+		}
+	}
+	storageSize += getFrozenStorageSize(typeIdEntries.size()) + getFrozenStorageSize(typeNameEntries.size());
+
+	// All tables share a single block. It can exceed the page size of the scoped allocator, so it is owned by the registry
+	std::byte* storage = static_cast<std::byte*>(allocator.alloc(storageSize, alignof(FrozenEntry)));
+	if (! storage) {
+		frozen = true;
+		return false;
+	}
+	frozenStorage = storage;
+	frozenStorageSize = storageSize;
+	bool res = frozenTypeIds.build(typeIdEntries, storage, allocator);
+	storage += getFrozenStorageSize(typeIdEntries.size());
+	res = frozenTypeNames.build(typeNameEntries, storage, allocator) && res;
+	storage += getFrozenStorageSize(typeNameEntries.size());
+	for (const FrozenEntry& typeEntry : typeIdEntries) {
+		const Type* type = types[typeEntry.value];
+		collectMemberNames(*type, memberEntries);
+		if (memberEntries.empty()) {
+			continue;
+		}
+		if (type->getSubClass() == Type::Subclass::Struct) {
+			res = static_cast<const StructType*>(type)->frozenProperties.build(memberEntries, storage, allocator) && res;
+		}
+		else {
+			res = static_cast<const EnumType*>(type)->frozenEnumerators.build(memberEntries, storage, allocator) && res;
+		}
+		storage += getFrozenStorageSize(memberEntries.size());
+	}
+
+	// Tables that failed to build stay invalid, and their lookups keep using the dynamic indices
+	frozen = true;
+	return res;
+}
+
+bool TypeDB::isFrozen() const {
+	return frozen;
 }
 
 Namespace& TypeDB::getGlobalNamespace() const {
@@ -48,23 +201,127 @@ const Type& TypeDB::getType(TypeId typeID) const {
 	return *type;
 }
 
+const char* TypeDB::internString(std::string_view str) const {
+	return stringTable->intern(str);
+}
+
 const Type* TypeDB::tryGetType(TypeId typeID) const {
-	// TODO O(n), optimize
-	for (const auto& type : types) {
-		if (type->getTypeId() == typeID) {
-			return type;
-		}
+	const uint32_t index = findTypeIndex(typeID);
+	return index != detail::HashIndex::invalidValue ? types[index] : nullptr;
+}
+
+uint32_t TypeDB::findTypeIndex(TypeId typeID) const {
+	static_assert(detail::PerfectHashTable::invalidValue == detail::HashIndex::invalidValue);
+	if (frozenTypeIds.isValid()) {
+		// Pointer hashing is a bijection, so equal hashes mean equal type ids
+		return frozenTypeIds.find(detail::hashPointer(typeID.impl));
 	}
-	return nullptr;
+	return typeIdIndex.find(detail::hashPointer(typeID.impl), [this, typeID](uint32_t i) { return types[i]->getTypeId() == typeID; });
 }
 
 const Type* TypeDB::tryGetType(const char* typeName) const {
-	for (const auto& type : types) {
-		if (! strcmp(type->getName(), typeName)) {
-			return type;
+	assert(typeName);
+	return tryGetType(std::string_view { typeName });
+}
+
+const Type* TypeDB::tryGetType(std::string_view typeName) const {
+	return tryGetType(typeName, hashString(typeName));
+}
+
+const Type* TypeDB::tryGetType(std::string_view typeName, uint64_t typeNameHash) const {
+	assert(typeNameHash == hashString(typeName));
+	if (frozenTypeNames.isValid()) {
+		const uint32_t index = frozenTypeNames.find(typeNameHash);
+		return index != detail::PerfectHashTable::invalidValue && typeName == types[index]->getName() ? types[index] : nullptr;
+	}
+	const uint32_t index = typeNameIndex.find(typeNameHash, [this, typeName](uint32_t i) { return typeName == types[i]->getName(); });
+	return index != detail::HashIndex::invalidValue ? types[index] : nullptr;
+}
+
+#if TY_REFLECTION_INSTRUMENTATION
+
+namespace {
+
+void appendStats(std::string& json, const char* name, const OperationStats& stats) {
+	char buffer[256];
+	std::snprintf(buffer, sizeof buffer,
+	              "\"%s\": { \"calls\": %" PRIu64 ", \"nanoseconds\": %" PRIu64 ", \"bytes\": %" PRIu64 ", \"scratchHighWater\": %" PRIu64 " }", name,
+	              stats.callCount, stats.nanoseconds, stats.bytes, stats.scratchHighWater);
+	json += buffer;
+}
+
+void appendString(std::string& json, const char* str) {
+	json += '"';
+	for (; *str; ++str) {
+		if (*str == '"' || *str == '\\') {
+			json += '\\';
 		}
+		json += *str;
 	}
-	return nullptr;
+	json += '"';
 }
 
+} // namespace
+
+TypeStats TypeDB::getTypeStats(const Type& type) const {
+	TypeStats stats {};
+	if (const uint32_t index = findTypeIndex(type.getTypeId()); index != detail::HashIndex::invalidValue) {
+		const detail::TypeCounters& counters = *typeCounters[index];
+		stats.write = detail::loadStats(counters.operations[(int)detail::Operation::write]);
+		stats.read = detail::loadStats(counters.operations[(int)detail::Operation::read]);
+		stats.clone = detail::loadStats(counters.operations[(int)detail::Operation::clone]);
+	}
+	return stats;
+}
+
+void TypeDB::resetTypeStats() {
+	for (detail::TypeCounters* counters : typeCounters) {
+		for (detail::OperationCounters& operationCounters : counters->operations) {
+			detail::resetCounters(operationCounters);
+		}
+	}
+}
+
+std::string TypeDB::exportTypeStats() const {
+	struct Item {
+		const Type* type;
+		TypeStats   stats;
+		uint64_t    nanoseconds;
+	};
+	std::vector<Item> items;
+	for (size_t i = 0; i < types.size(); ++i) {
+		const Type* type = types[i];
+		if (findTypeIndex(type->getTypeId()) != i) {
+			continue; // duplicated registration
+		}
+		const TypeStats stats = getTypeStats(*type);
+		if (stats.write.callCount || stats.read.callCount || stats.clone.callCount) {
+			items.push_back({ type, stats, stats.write.nanoseconds + stats.read.nanoseconds + stats.clone.nanoseconds });
+		}
+	}
+	std::stable_sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.nanoseconds > b.nanoseconds; });
+
+	std::string json = "{\n  \"types\": [";
+	for (size_t i = 0; i < items.size(); ++i) {
+		json += i ? ",\n    { \"name\": " : "\n    { \"name\": ";
+		appendString(json, items[i].type->getName() ? items[i].type->getName() : "");
+		json += ", ";
+		appendStats(json, "write", items[i].stats.write);
+		json += ", ";
+		appendStats(json, "read", items[i].stats.read);
+		json += ", ";
+		appendStats(json, "clone", items[i].stats.clone);
+		json += " }";
+	}
+	json += "\n  ]\n}\n";
+	return json;
+}
+
+detail::OperationCounters* TypeDB::getOperationCounters(const Type& type, detail::Operation operation) const {
+	const uint32_t index = findTypeIndex(type.getTypeId());
+	return index != detail::HashIndex::invalidValue ? &typeCounters[index]->operations[(int)operation] : nullptr;
+}
+
+#endif
+
 } // namespace Typhoon::Reflection
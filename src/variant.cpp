@@ -2,42 +2,130 @@
 #include "reflection.h"
 #include "typeDB.h"
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+
 namespace Typhoon::Reflection {
 
-Variant::Variant()
-    : typeId {
-	nullTypeId
+namespace {
+
+// Blocks of the same size class are recycled. Larger blocks and overaligned ones go straight to the heap
+constexpr size_t minBlockSize = 64;
+constexpr size_t blockSizeClassCount = 5; // up to 1024 bytes
+constexpr size_t maxPooledBlocks = 32;    // per size class and thread
+constexpr size_t blockAlignment = alignof(std::max_align_t);
+
+size_t getBlockSizeClass(size_t size) {
+	size_t sizeClass = 0;
+	while ((minBlockSize << sizeClass) < size) {
+		++sizeClass;
+	}
+	return sizeClass;
 }
-#ifdef _DEBUG
-, storage {
+
+struct BlockPool {
+	void*  blocks[blockSizeClassCount][maxPooledBlocks];
+	size_t blockCount[blockSizeClassCount];
+
+	~BlockPool();
+};
+
+// Blocks can be freed by destructors of thread_local and static objects, after the pool of the thread is destroyed
+thread_local bool      blockPoolDestroyed = false;
+thread_local BlockPool blockPool {};
+
+BlockPool::~BlockPool() {
+	for (size_t sizeClass = 0; sizeClass < blockSizeClassCount; ++sizeClass) {
+		for (size_t i = 0; i < blockCount[sizeClass]; ++i) {
+			::operator delete(blocks[sizeClass][i], std::align_val_t { blockAlignment });
+		}
+		blockCount[sizeClass] = 0;
+	}
+	blockPoolDestroyed = true;
 }
+
+} // namespace
+
+namespace detail {
+
+const char* internString(std::string_view str) {
+	// Default constructed variants don't need the registry
+	return str.empty() ? emptyString : getTypeDB().internString(str);
+}
+
+void* allocVariantBlock(size_t size, size_t alignment) {
+	alignment = std::max(alignment, blockAlignment);
+	if (alignment == blockAlignment && ! blockPoolDestroyed) {
+		if (const size_t sizeClass = getBlockSizeClass(size); sizeClass < blockSizeClassCount) {
+			if (size_t& count = blockPool.blockCount[sizeClass]; count) {
+				return blockPool.blocks[sizeClass][--count];
+			}
+			size = minBlockSize << sizeClass;
+		}
+	}
+	return ::operator new(size, std::align_val_t { alignment });
+}
+
+void freeVariantBlock(void* block, size_t size, size_t alignment) {
+	alignment = std::max(alignment, blockAlignment);
+	if (alignment == blockAlignment && ! blockPoolDestroyed) {
+		if (const size_t sizeClass = getBlockSizeClass(size); sizeClass < blockSizeClassCount) {
+			if (size_t& count = blockPool.blockCount[sizeClass]; count < maxPooledBlocks) {
+				blockPool.blocks[sizeClass][count++] = block;
+				return;
+			}
+		}
+	}
+	::operator delete(block, std::align_val_t { alignment });
+}
+
+const Type* findVariantType(TypeId typeId) {
+	const Type* type = getTypeDB().tryGetType(typeId);
+	assert(type);
+	return type;
+}
+
+} // namespace detail
+
+Variant::Variant()
+    : typeId { nullTypeId }
+    , type { nullptr }
+    , name { detail::emptyString }
+    , external { false }
+    , trivial { true }
+#ifdef _DEBUG
+    , storage {}
 #endif
-{}
+{
+}
 
 Variant::Variant(const Variant& other)
-    : typeId { nullTypeId } {
+    : Variant {} {
 	*this = other;
 }
 
 Variant::Variant(Variant&& other) noexcept
-    : typeId { nullTypeId } {
+    : Variant {} {
 	*this = std::move(other);
 }
 
 Variant::Variant(const void* data, TypeId typeId, std::string_view name)
-    : typeId { typeId }
-    , name { name } {
-	const auto& type = getType();
-	assert(type.getSize() <= sizeof storage);
-	type.copyConstructObject(&storage, data);
+    : Variant {} {
+	const Type* newType = detail::findVariantType(typeId);
+	newType->copyConstructObject(allocStorage(newType->getSize(), newType->getAlignment()), data);
+	this->typeId = typeId;
+	this->name = detail::internString(name);
+	setType(newType, newType->isTriviallyCopyable());
 }
 
 Variant::Variant(TypeId typeId, std::string_view name)
-    : typeId { typeId }
-    , name { name } {
-	const auto& type = getType();
-	assert(type.getSize() <= sizeof storage);
-	type.constructObject(&storage);
+    : Variant {} {
+	const Type* newType = detail::findVariantType(typeId);
+	newType->constructObject(allocStorage(newType->getSize(), newType->getAlignment()));
+	this->typeId = typeId;
+	this->name = detail::internString(name);
+	setType(newType, newType->isTriviallyCopyable());
 }
 
 Variant::~Variant() {
@@ -45,63 +133,108 @@ Variant::~Variant() {
 }
 
 Variant& Variant::operator=(const Variant& other) {
-	if (other.typeId == typeId) {
-		if (typeId) {
-			const Type& type = getType();
-			type.copyObject(&storage, &other.storage);
-		}
+	if (this == &other) {
+		return *this;
+	}
+	if (trivial && other.trivial) {
+		// Scalars and other plain values
+		copyTrivial(other);
+	}
+	else if (other.typeId == typeId) {
+		type->copyObject(getStorage(), other.getStorage());
 	}
 	else {
 		destruct();
-		if (other.typeId) {
-			const Type& type = other.getType();
-			type.copyConstructObject(&storage, &other.storage);
+		if (other.type) {
+			other.type->copyConstructObject(allocStorage(other.type->getSize(), other.type->getAlignment()), other.getStorage());
+			typeId = other.typeId;
+			setType(other.type, other.trivial);
 		}
-		typeId = other.typeId;
 	}
 	name = other.name;
 	return *this;
 }
 
 Variant& Variant::operator=(Variant&& other) noexcept {
-	if (other.typeId == typeId) {
-		if (typeId) {
-			const Type& type = getType();
-			type.moveObject(&storage, &other.storage);
-		}
+	if (this == &other) {
+		return *this;
+	}
+	if (trivial && other.trivial) {
+		copyTrivial(other);
+	}
+	else if (other.external) {
+		// Take the block, leaving other empty
+		destruct();
+		std::memcpy(&storage, &other.storage, sizeof(void*));
+		typeId = other.typeId;
+		type = other.type;
+		external = true;
+		trivial = false;
+		other.typeId = nullTypeId;
+		other.type = nullptr;
+		other.external = false;
+		other.trivial = true;
+	}
+	else if (other.typeId == typeId) {
+		type->moveObject(getStorage(), other.getStorage());
 	}
 	else {
 		destruct();
-		if (other.typeId) {
-			const Type& type = other.getType();
-			type.moveConstructObject(&storage, &other.storage);
+		if (other.type) {
+			other.type->moveConstructObject(allocStorage(other.type->getSize(), other.type->getAlignment()), other.getStorage());
+			typeId = other.typeId;
+			setType(other.type, other.trivial);
 		}
-		typeId = other.typeId;
 	}
-	name = std::move(other.name);
+	name = other.name;
 	return *this;
 }
 
 const Type& Variant::getType() const {
-	return detail::getTypeDB().getType(typeId);
+	assert(type);
+	return *type;
 }
 
-const std::string& Variant::getName() const {
-	return name;
+void* Variant::allocStorage(size_t size, size_t alignment) {
+	assert(! external);
+	if (fitsInline(size, alignment)) {
+		return &storage;
+	}
+	void* block = detail::allocVariantBlock(size, alignment);
+	std::memcpy(&storage, &block, sizeof block);
+	external = true;
+	return block;
+}
+
+void Variant::setType(const Type* newType, bool isTriviallyCopyable) {
+	type = newType;
+	trivial = isTriviallyCopyable && ! external;
+}
+
+void Variant::copyTrivial(const Variant& other) {
+	typeId = other.typeId;
+	type = other.type;
+	std::memcpy(&storage, &other.storage, sizeof storage);
 }
 
 void Variant::destruct() {
-	if (typeId != nullTypeId) {
-		getType().destructObject(&storage);
-		typeId = nullTypeId;
+	if (! trivial) {
+		type->destructObject(getStorage());
+		if (external) {
+			detail::freeVariantBlock(getStorage(), type->getSize(), type->getAlignment());
+			external = false;
+		}
+		trivial = true;
 	}
+	typeId = nullTypeId;
+	type = nullptr;
 }
 
 bool Variant::operator==(const Variant& other) const {
 	if (typeId != other.typeId) {
 		return false;
 	}
-	return getType().compareObjects(getStorage(), other.getStorage());
+	return ! type || type->compareObjects(getStorage(), other.getStorage());
 }
 
 bool Variant::operator!=(const Variant& other) const {
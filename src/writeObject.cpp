@@ -6,7 +6,9 @@
 #include "context.h"
 #include "enumType.h"
 #include "flags.h"
+#include "instrumentation.h"
 #include "pointerType.h"
+#include "parallel.h"
 #include "property.h"
 #include "referenceType.h"
 #include "serializeBuiltIns.h"
@@ -17,6 +19,8 @@
 #include <cassert>
 #include <core/ptrUtil.h>
 #include <core/scopedAllocator.h>
+#include <string>
+#include <vector>
 
 namespace Typhoon::Reflection {
 
@@ -46,11 +50,57 @@ void writeData(ConstDataPtr data, const Type& type, OutputArchive& archive, cons
 	writeObjectImpl(data, type, *context.typeDB, archive, *context.pagedAllocator);
 }
 
+void writeDataParallel(ConstDataPtr data, const Type& type, OutputArchive& archive, const Context& context, Executor& executor) {
+	assert(data);
+	// Values are split by index. Arrays of numbers are excluded, as they are written in bulk anyway
+	const ContainerType* containerType = nullptr;
+	size_t               count = 0;
+	if (type.getSubClass() == Type::Subclass::Container && ! type.getCustomWriter() && context.typeDB->isFrozen()) {
+		containerType = static_cast<const ContainerType*>(&type);
+		if (! containerType->getKeyType() && containerType->isContiguous() && ! isNumberType(containerType->getValueType()->getTypeId())) {
+			count = containerType->getElementCount(data);
+		}
+	}
+	const size_t chunkCount = getChunkCount(count, executor);
+	if (! chunkCount || ! archive.canCreateChunkArchive()) {
+		writeData(data, type, archive, context);
+		return;
+	}
+
+	const Type&              valueType = *containerType->getValueType();
+	ConstDataPtr const       values = containerType->getElementData(data);
+	std::vector<std::string> chunks(chunkCount);
+	executor.run(chunkCount, [&](size_t chunk) {
+		// Workers need their own allocator for temporaries. The chunk archive is destroyed first
+		ThreadContextScope             contextScope;
+		const Context&                 threadContext = getContext();
+		std::unique_ptr<OutputArchive> chunkArchive = archive.createChunkArchive();
+		const size_t                   begin = count * chunk / chunkCount;
+		const size_t                   end = count * (chunk + 1) / chunkCount;
+		chunkArchive->beginArray();
+		for (size_t i = begin; i < end; ++i) {
+			writeObjectImpl(advancePointer(values, i * valueType.getSize()), valueType, *threadContext.typeDB, *chunkArchive,
+			                *threadContext.pagedAllocator);
+		}
+		chunkArchive->endArray();
+		chunks[chunk] = chunkArchive->saveToString();
+	});
+
+	archive.beginArray();
+	for (const std::string& chunk : chunks) {
+		archive.appendChunk(chunk);
+	}
+	archive.endArray();
+}
+
 } // namespace detail
 
 namespace {
 
 void writeObjectImpl(ConstDataPtr data, const Type& type, const TypeDB& typeDB, OutputArchive& archive, LinearAllocator& tempAllocator) {
+#if TY_REFLECTION_INSTRUMENTATION
+	detail::InstrumentationScope instrumentationScope { detail::Operation::write, type, typeDB, tempAllocator, archive };
+#endif
 	if (const CustomWriter& customWriter = type.getCustomWriter(); customWriter) {
 		customWriter(data, archive);
 	}
@@ -59,33 +109,46 @@ void writeObjectImpl(ConstDataPtr data, const Type& type, const TypeDB& typeDB,
 	}
 }
 
-void writeStructProperties(ConstDataPtr data, const StructType& structType, const TypeDB& typeDB, OutputArchive& archive,
-                           LinearAllocator& tempAllocator) {
-	ConstDataPtr const self = data;
-	for (const auto& property : structType.getProperties()) {
-		if (property.getFlags() & Flags::writeable) {
-			const Type& valueType = property.getValueType();
-			void*       allocOffs = tempAllocator.getOffset();
-			// Allocate a temporary for the value
-			if (void* temporary = tempAllocator.alloc(valueType.getSize(), valueType.getAlignment()); temporary) {
-				valueType.constructObject(temporary);
-				property.getValue(self, temporary);
-				archive.setKey(property.getName());
-				writeObjectImpl(temporary, valueType, typeDB, archive, tempAllocator);
-				valueType.destructObject(temporary);
-			}
-			tempAllocator.rewind(allocOffs);
-		}
+void writeProperty(const PropertyOp& op, ConstDataPtr value, const TypeDB& typeDB, OutputArchive& archive, LinearAllocator& tempAllocator) {
+#if TY_REFLECTION_INSTRUMENTATION
+	detail::InstrumentationScope instrumentationScope { detail::Operation::write, *op.valueType, typeDB, tempAllocator, archive };
+#endif
+	switch (op.code) {
+	case PropertyOp::Code::custom:
+		op.valueType->getCustomWriter()(value, archive);
+		break;
+	case PropertyOp::Code::structure:
+		writeStruct(value, *op.valueType, typeDB, archive, tempAllocator);
+		break;
+	case PropertyOp::Code::generic:
+		perClassWriters[(int)op.valueType->getSubClass()](value, *op.valueType, typeDB, archive, tempAllocator);
+		break;
 	}
 }
 
 void writeStruct(ConstDataPtr data, const Type& type, const TypeDB& typeDB, OutputArchive& archive, LinearAllocator& tempAllocator) {
+	const StructType&  structType = static_cast<const StructType&>(type);
+	ConstDataPtr const self = data;
 	archive.beginObject();
-	const StructType* structType = static_cast<const StructType*>(&type);
-	do {
-		writeStructProperties(data, *structType, typeDB, archive, tempAllocator);
-		structType = structType->getParentType();
-	} while (structType);
+	for (const PropertyOp& op : structType.getWritePlan()) {
+		if (op.fieldOffset != Property::noFieldOffset) {
+			// Plain data member, write it in place
+			archive.setKey(op.property->getName());
+			writeProperty(op, advancePointer(self, op.fieldOffset), typeDB, archive, tempAllocator);
+			continue;
+		}
+		const Type& valueType = *op.valueType;
+		void*       allocOffs = tempAllocator.getOffset();
+		// Allocate a temporary for the value
+		if (void* temporary = tempAllocator.alloc(valueType.getSize(), valueType.getAlignment()); temporary) {
+			valueType.constructObject(temporary);
+			op.property->getValue(self, temporary);
+			archive.setKey(op.property->getName());
+			writeProperty(op, temporary, typeDB, archive, tempAllocator);
+			valueType.destructObject(temporary);
+		}
+		tempAllocator.rewind(allocOffs);
+	}
 	archive.endObject();
 }
 
@@ -96,33 +159,43 @@ void writeEnum(ConstDataPtr data, const Type& type, const TypeDB& /*typeDB*/, Ou
 	}
 }
 
-void writeBitMask(ConstDataPtr data, const Type& type, const TypeDB& /*typeDB*/, OutputArchive& archive, LinearAllocator& /*tempAllocator*/) {
+void writeBitMask(ConstDataPtr data, const Type& type, const TypeDB& /*typeDB*/, OutputArchive& archive, LinearAllocator& tempAllocator) {
 	const BitMaskType& bitMaskType = static_cast<const BitMaskType&>(type);
 	// Cast the source type to an uint64_t
 	BitMaskStorageType bitMask = 0;
 	std::memcpy(&bitMask, data, type.getSize());
 
-	char str[1024];
-	str[0] = 0;
-	int  length = 0;
-	bool res = true;
-
-	bool first = true;
-	for (const BitMaskConstant& enumerator : bitMaskType.getEnumerators()) {
-		if ((bitMask & enumerator.mask) == enumerator.mask) {
-			// Append enumerator name
-			const int r = snprintf(str + length, std::size(str) - length, first ? "%s" : "|%s", enumerator.name);
-			if (r < 0) {
-				res = false;
-				break;
-			}
-			length += r;
+	auto isSet = [bitMask](const BitMaskConstant& constant) { return (bitMask & constant.mask) == constant.mask; };
+
+	// Measure the string, then join the names of the set constants in temporary memory
+	size_t length = 0;
+	for (const BitMaskConstant& constant : bitMaskType.getEnumerators()) {
+		if (isSet(constant)) {
+			length += (length ? 1 : 0) + strlen(constant.name);
 		}
-		first = false;
 	}
-	if (res) {
-		archive.write(static_cast<const char*>(str));
+	void*       allocOffs = tempAllocator.getOffset();
+	char*       str = static_cast<char*>(tempAllocator.alloc(length + 1, alignof(char)));
+	std::string heapString;
+	if (! str) {
+		// Too long for the temporary memory
+		heapString.resize(length);
+		str = heapString.data();
 	}
+	char* end = str;
+	for (const BitMaskConstant& constant : bitMaskType.getEnumerators()) {
+		if (isSet(constant)) {
+			if (end != str) {
+				*end++ = '|';
+			}
+			const size_t nameLength = strlen(constant.name);
+			std::memcpy(end, constant.name, nameLength);
+			end += nameLength;
+		}
+	}
+	*end = 0; // some archives expect null terminated views
+	archive.write(std::string_view { str, length });
+	tempAllocator.rewind(allocOffs);
 }
 
 void writeContainer(ConstDataPtr data, const Type& type, const TypeDB& typeDB, OutputArchive& archive, LinearAllocator& tempAllocator) {
@@ -130,6 +203,18 @@ void writeContainer(ConstDataPtr data, const Type& type, const TypeDB& typeDB, O
 	const Type*          keyType = containerType.getKeyType();
 	const Type*          valueType = containerType.getValueType();
 
+	if (! keyType && containerType.isContiguous() && detail::isNumberType(valueType->getTypeId())) {
+		// Numbers are written in bulk, as raw bytes if the archive supports them
+		ConstDataPtr values = containerType.getElementData(data);
+		const size_t count = containerType.getElementCount(data);
+		if (! archive.writeBlob(values, count * valueType->getSize())) {
+			archive.beginArray();
+			detail::writeNumbers(values, count, valueType->getTypeId(), archive);
+			archive.endArray();
+		}
+		return;
+	}
+
 	archive.beginArray();
 
 	ScopedAllocator scopedAllocator { tempAllocator };
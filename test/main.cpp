@@ -1,8 +1,11 @@
 #include <Catch/catch_amalgamated.hpp>
 
 #include "testClasses.h"
+#include <algorithm>
+#include <cstdio>
 #include <reflection/reflection.h>
 #include <string>
+#include <thread>
 
 void registerUserTypes();
 
@@ -105,6 +108,24 @@ TEST_CASE("Primitives") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary Serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -163,6 +184,24 @@ TEST_CASE("Enum") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary Serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -172,6 +211,35 @@ TEST_CASE("Enum") {
 	}
 }
 
+TEST_CASE("Enum lookup") {
+	using namespace refl;
+	const auto& seasonType = static_cast<const EnumType&>(getType<SeasonType>());
+	const auto& priorityType = static_cast<const EnumType&>(getType<Priority>());
+
+	auto findName = [](const EnumType& type, auto value) -> std::string_view {
+		const Enumerator* enumerator = type.findEnumeratorByValue(&value, sizeof value);
+		return enumerator ? enumerator->name : "";
+	};
+
+	// Contiguous values
+	CHECK(findName(seasonType, SeasonType::spring) == "spring");
+	CHECK(findName(seasonType, SeasonType::winter) == "winter");
+	CHECK(findName(seasonType, static_cast<SeasonType>(4)) == "");
+	CHECK(findName(seasonType, static_cast<SeasonType>(-1)) == "");
+	// Sparse and negative values. Aliases resolve to the first enumerator
+	CHECK(findName(priorityType, Priority::lowest) == "lowest");
+	CHECK(findName(priorityType, Priority::low) == "low");
+	CHECK(findName(priorityType, Priority::urgent) == "high");
+	CHECK(findName(priorityType, Priority::highest) == "highest");
+	CHECK(findName(priorityType, static_cast<Priority>(5)) == "");
+
+	const Enumerator* urgent = priorityType.findEnumeratorByName("urgent");
+	REQUIRE(urgent);
+	const Priority urgentValue = Priority::urgent;
+	CHECK(std::memcmp(urgent->value, &urgentValue, sizeof urgentValue) == 0);
+	CHECK(priorityType.findEnumeratorByName("medium") == nullptr);
+}
+
 TEST_CASE("BitMask") {
 	using namespace refl;
 	ActionBitmask flags { ActionFlags::running, ActionFlags::smiling };
@@ -206,6 +274,35 @@ TEST_CASE("BitMask") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+
+	SECTION("JSON format") {
+		flags = ActionBitmask { ActionFlags::smiling };
+		JSONOutputArchive outArchive;
+		CHECK(write(outArchive).find(R"("smiling")") != std::string::npos);
+
+		// Names must match whole tokens
+		JSONInputArchive inArchive;
+		REQUIRE(inArchive.initialize(R"({ "flags": "runningfast| smiling |unknown" })"));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary Serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -258,6 +355,24 @@ TEST_CASE("C array") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -303,6 +418,28 @@ TEST_CASE("std::vector") {
 		JSONInputArchive  inArchive;
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
+		// Storage is reserved once from the element count
+		Vector reserved;
+		REQUIRE(inArchive.read(elementName, reserved));
+		CHECK(reserved.capacity() == vec.size());
+	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
 	}
 #endif
 
@@ -311,6 +448,103 @@ TEST_CASE("std::vector") {
 		cloneObject(&cloned, vec);
 		CHECK(vec == cloned);
 	}
+
+	SECTION("Clone into non-empty") {
+		// The values replace the content of the destination
+		Vector cloned { "Giovanni", "Paola" };
+		cloneObject(&cloned, vec);
+		CHECK(vec == cloned);
+	}
+}
+
+TEST_CASE("Contiguous containers") {
+	using namespace refl;
+	const std::vector<float> floats { 1.5f, -2.f, 3.25f, 0.f, 1e6f };
+	const std::array<int, 4> ints { 7, -8, 9, 1 << 20 };
+
+	auto write = [&](OutputArchive& archive) {
+		archive.write("floats", floats);
+		archive.write("ints", ints);
+		return archive.saveToString();
+	};
+
+	auto read = [&](InputArchive& archive) {
+		// The container is resized to the number of elements in the archive
+		std::vector<float> in_floats { 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f };
+		std::array<int, 4> in_ints {};
+		REQUIRE(archive.read("floats", in_floats));
+		REQUIRE(archive.read("ints", in_ints));
+		CHECK(in_floats == floats);
+		CHECK(in_ints == ints);
+	};
+
+#if TY_REFLECTION_XML
+	SECTION("XML serialization") {
+		XMLOutputArchive outArchive;
+		std::string      content = write(outArchive);
+		XMLInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_JSON
+	SECTION("JSON serialization") {
+		JSONOutputArchive outArchive;
+		std::string       content = write(outArchive);
+		JSONInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+		// Numbers are stored as raw bytes
+		REQUIRE(inArchive.beginElement("floats"));
+		CHECK(inArchive.getValueType() == ValueType::Blob);
+		inArchive.endElement();
+		// Fixed size arrays only accept blobs of their length
+		std::array<int, 3> shortInts {};
+		CHECK_FALSE(inArchive.read("ints", shortInts));
+
+		// Bools are only copied from bytes that hold 0 or 1
+		const std::array<bool, 4> bools { true, false, false, true };
+		BinaryOutputArchive       boolArchive;
+		boolArchive.write("bools", bools);
+		std::string         boolContent = boolArchive.saveToString();
+		std::array<bool, 4> inBools {};
+		REQUIRE(inArchive.initialize(boolContent.data(), boolContent.size()));
+		REQUIRE(inArchive.read("bools", inBools));
+		CHECK(inBools == bools);
+		const size_t offset = boolContent.rfind(std::string_view { "\x01\x00\x00\x01", 4 });
+		REQUIRE(offset != std::string::npos);
+		boolContent[offset + 1] = 2;
+		CHECK_FALSE((inArchive.initialize(boolContent.data(), boolContent.size()) && inArchive.read("bools", inBools)));
+	}
+#endif
+
+	SECTION("Clone") {
+		std::vector<float> cloned { 4.f, 5.f };
+		cloneObject(&cloned, floats);
+		CHECK(cloned == floats);
+		std::array<int, 4> clonedInts {};
+		cloneObject(&clonedInts, ints);
+		CHECK(clonedInts == ints);
+	}
 }
 
 TEST_CASE("std::map") {
@@ -348,6 +582,24 @@ TEST_CASE("std::map") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -357,6 +609,114 @@ TEST_CASE("std::map") {
 	}
 }
 
+TEST_CASE("Arena") {
+	using namespace refl;
+	using Names = std::pmr::vector<std::pmr::string>;
+	using Table = std::pmr::map<std::pmr::string, std::pmr::vector<int>>;
+	const Names names { "a string longer than the small string buffer", "b" };
+	const Table table { { "squares", { 0, 1, 4, 9 } }, { "large", std::pmr::vector<int>(30000, 7) } };
+
+	auto write = [&](OutputArchive& archive) {
+		archive.write("names", names);
+		archive.write("table", table);
+		return archive.saveToString();
+	};
+
+	auto read = [&](InputArchive& archive) {
+		Typhoon::HeapAllocator  heapAllocator;
+		Typhoon::PagedAllocator pagedAllocator { heapAllocator };
+		ArenaResource           arena { pagedAllocator, heapAllocator };
+		// Values are replaced, so vectors and strings holding values are rebound too
+		Names inNames { "old" };
+		Table inTable;
+		archive.setArena(&arena);
+		REQUIRE(archive.read("names", inNames));
+		REQUIRE(archive.read("table", inTable));
+		CHECK(inNames == names);
+		CHECK(inTable == table);
+		CHECK(inNames.get_allocator().resource() == &arena);
+		CHECK(inNames[0].get_allocator().resource() == &arena);
+		CHECK(inTable.get_allocator().resource() == &arena);
+		// Larger than a page, allocated from the fallback allocator
+		CHECK(inTable["large"].get_allocator().resource() == &arena);
+		archive.setArena(nullptr);
+	};
+
+#if TY_REFLECTION_XML
+	SECTION("XML serialization") {
+		XMLOutputArchive outArchive;
+		std::string      content = write(outArchive);
+		XMLInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_JSON
+	SECTION("JSON serialization") {
+		JSONOutputArchive outArchive;
+		std::string       content = write(outArchive);
+		JSONInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+
+	SECTION("Own allocator") {
+		JSONOutputArchive outArchive;
+		std::string       content = write(outArchive);
+		JSONInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		Names inNames;
+		REQUIRE(inArchive.read("names", inNames));
+		CHECK(inNames == names);
+		CHECK(inNames.get_allocator().resource() == std::pmr::get_default_resource());
+	}
+
+	SECTION("Own resources") {
+		JSONOutputArchive outArchive;
+		std::string       content = write(outArchive);
+		JSONInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		Typhoon::HeapAllocator              heapAllocator;
+		Typhoon::PagedAllocator             pagedAllocator { heapAllocator };
+		ArenaResource                       arena { pagedAllocator, heapAllocator };
+		std::pmr::monotonic_buffer_resource ownResource;
+		// Containers that keep their resource, and their values, are not rebound to the arena
+		Names inNames { &ownResource };
+		Table inTable { { "old", { 1 } } };
+		inArchive.setArena(&arena);
+		REQUIRE(inArchive.read("names", inNames));
+		REQUIRE(inArchive.read("table", inTable));
+		CHECK(inNames == names);
+		CHECK(inNames.get_allocator().resource() == &ownResource);
+		CHECK(inNames[0].get_allocator().resource() == &ownResource);
+		CHECK(inTable.get_allocator().resource() == std::pmr::get_default_resource());
+		for (const auto& [key, value] : inTable) {
+			CHECK(key.get_allocator().resource() == std::pmr::get_default_resource());
+			CHECK(value.get_allocator().resource() == std::pmr::get_default_resource());
+		}
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
+#endif
+}
+
 TEST_CASE("std::array") {
 	using namespace refl;
 	using Array = std::array<int, 16>;
@@ -396,6 +756,24 @@ TEST_CASE("std::array") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -440,6 +818,24 @@ TEST_CASE("std::pair") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -485,6 +881,24 @@ TEST_CASE("std::tuple") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -528,6 +942,24 @@ TEST_CASE("std::unique_ptr") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -571,6 +1003,24 @@ TEST_CASE("std::shared_ptr") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -616,6 +1066,35 @@ TEST_CASE("std::string_view") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+
+	SECTION("JSON stream members") {
+		// The views outlive the tokens they were parsed from
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(R"({ "views": { "first": "first value", "second": "second value", "third": "third value" } })"));
+		StringViews views;
+		REQUIRE(inArchive.read("views", views));
+		CHECK(views.first == "first value");
+		CHECK(views.second == "second value");
+		CHECK(std::string_view { views.third } == "third value");
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -667,6 +1146,24 @@ TEST_CASE("Class") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -716,6 +1213,24 @@ TEST_CASE("Struct") {
 		REQUIRE(inArchive.initialize(content.data()));
 		read(inArchive);
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive      outArchive;
+		std::string            content = write(outArchive);
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary serialization") {
+		BinaryOutputArchive outArchive;
+		std::string         content = write(outArchive);
+		BinaryInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
 #endif
 
 	SECTION("Clone") {
@@ -725,15 +1240,99 @@ TEST_CASE("Struct") {
 	}
 }
 
+TEST_CASE("Clone plain data") {
+	using namespace refl;
+	const auto& coordsType = static_cast<const StructType&>(getType<Coords>());
+	const auto& particleType = static_cast<const StructType&>(getType<Particle>());
+	CHECK(coordsType.isMemoryCopyable());
+	// The bytes of the reflected fields are merged, the cache is excluded
+	REQUIRE(particleType.isClonedByCopy());
+	CHECK_FALSE(particleType.isMemoryCopyable());
+	REQUIRE(particleType.getCloneRanges().size() == 1);
+	CHECK(particleType.getCloneRanges()[0].size == offsetof(Particle, cache));
+	// Properties with getters and setters
+	CHECK_FALSE(static_cast<const StructType&>(getType<Fog>()).isClonedByCopy());
+
+	std::vector<Particle> particles(100);
+	for (size_t i = 0; i < particles.size(); ++i) {
+		const float f = static_cast<float>(i);
+		particles[i] = { { f, f + 1.f, f + 2.f }, { 0.5f, f, 1.f }, SeasonType::winter, f * 0.1f, 1 };
+	}
+	std::vector<Particle> clonedParticles;
+	REQUIRE(cloneObject(&clonedParticles, particles) == ErrorCode::ok);
+	REQUIRE(clonedParticles.size() == particles.size());
+	for (size_t i = 0; i < particles.size(); ++i) {
+		const Particle& p = particles[i];
+		const Particle& c = clonedParticles[i];
+		CHECK((c.position == p.position && c.color == p.color && c.season == p.season && c.age == p.age && c.cache == 0));
+	}
+
+	const std::vector<Coords> coords(50, Coords { 1.f, 2.f, 3.f });
+	std::vector<Coords>       clonedCoords;
+	REQUIRE(cloneObject(&clonedCoords, coords) == ErrorCode::ok);
+	CHECK(clonedCoords == coords);
+}
+
+TEST_CASE("Struct member order") {
+	using namespace refl;
+
+	// Members in any order, with unknown ones
+	auto read = [&](InputArchive& archive) {
+		Coords coords { 0.f, 0.f, 0.f };
+		REQUIRE(archive.read("coords", coords));
+		CHECK(coords == Coords { 1.f, 2.f, 3.f });
+	};
+
+#if TY_REFLECTION_XML
+	SECTION("XML") {
+		const char*     content = "<root><coords><z>3</z><w>4</w><x>1</x><!-- comment --><y>2</y></coords></root>";
+		XMLInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_JSON
+	const char* content = R"({ "coords": { "z": 3.0, "w": { "x": 4.0 }, "x": 1.0, "y": 2.0 } })";
+	SECTION("JSON") {
+		JSONInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content));
+		read(inArchive);
+	}
+
+	SECTION("JSON stream") {
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content));
+		read(inArchive);
+	}
+
+	SECTION("Hidden property") {
+		// After "a", the next property in the read plan is the x of the base, which is hidden by the x of the derived struct
+		JSONInputArchive inArchive;
+		REQUIRE(inArchive.initialize(R"({ "object": { "a": 1, "x": 2 } })"));
+		HidingDerived object;
+		REQUIRE(inArchive.read("object", object));
+		CHECK(object.a == 1);
+		CHECK(object.x == 2);
+		CHECK(static_cast<const HidingBase&>(object).x == 0);
+	}
+#endif
+}
+
 TEST_CASE("Variant") {
 	using namespace refl;
 
-	using VariantArray = std::array<Variant, 2>;
-	const VariantArray variants { Variant { 3.14, "double" }, Variant { 41, "int" } };
+	Fog fog;
+	setDensity(fog, 10.f);
+	// Stored in a heap block
+	static_assert(! Variant::fitsInline(sizeof(Fog), alignof(Fog)));
+
+	using VariantArray = std::array<Variant, 3>;
+	const VariantArray variants { Variant { 3.14, "double" }, Variant { 41, "int" }, Variant { fog, "fog" } };
 	VariantArray       otherVariants;
 	VariantArray       clonedVariants;
 
-	auto        compare = [](const VariantArray& b0, const VariantArray& b1) { return b0[0] == b1[0] && b0[1] == b1[1]; };
+	auto compare = [](const VariantArray& b0, const VariantArray& b1) { return b0[0] == b1[0] && b0[1] == b1[1] && b0[2] == b1[2]; };
 	const char* key = "variants";
 
 #if TY_REFLECTION_XML
@@ -762,6 +1361,32 @@ TEST_CASE("Variant") {
 		REQUIRE(inArchive.read(key, otherVariants));
 		CHECK(compare(otherVariants, variants));
 	}
+
+	SECTION("JSON stream serialization") {
+		JSONOutputArchive outArchive;
+
+		outArchive.write(key, variants);
+		std::string archiveContent = outArchive.saveToString();
+
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(archiveContent.data()));
+		REQUIRE(inArchive.read(key, otherVariants));
+		CHECK(compare(otherVariants, variants));
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary Serialization") {
+		BinaryOutputArchive outArchive;
+
+		outArchive.write(key, variants);
+		std::string archiveContent = outArchive.saveToString();
+
+		BinaryInputArchive inArchive;
+		REQUIRE(inArchive.initialize(archiveContent.data(), archiveContent.size()));
+		REQUIRE(inArchive.read(key, otherVariants));
+		CHECK(compare(otherVariants, variants));
+	}
 #endif
 
 	SECTION("Clone") {
@@ -770,6 +1395,596 @@ TEST_CASE("Variant") {
 	}
 }
 
+TEST_CASE("Variant storage") {
+	using namespace refl;
+	static_assert(sizeof(Variant) <= 64);
+
+	Fog fog;
+	setDensity(fog, 10.f);
+	Variant small { 41, "value" };
+	Variant large { fog, "value" };
+	// Names are interned
+	CHECK(small.getName() == large.getName());
+	CHECK(std::string_view { Variant {}.getName() }.empty());
+	// Names longer than a page of the table
+	const std::string longName(5000, 'n');
+	CHECK(Variant { 1, longName }.getName() == Variant { 2, longName }.getName());
+	CHECK(std::string_view { Variant { 3, "next" }.getName() } == "next");
+
+	Variant copy { large };
+	CHECK(copy == large);
+	CHECK(copy.getStorage() != large.getStorage());
+
+	// Moving a large value takes its block
+	const void* storage = copy.getStorage();
+	Variant     moved { std::move(copy) };
+	CHECK(moved.getStorage() == storage);
+	CHECK(moved.get<Fog>() == fog);
+	CHECK_FALSE(copy.getTypeId());
+
+	moved = small;
+	CHECK(moved.get<int>() == 41);
+	moved.set(fog);
+	CHECK(moved == large);
+
+	// Scalars are copied without the registry, empty variants compare equal
+	std::vector<Variant> scalars { Variant { 1.5, "a" }, Variant { 2, "b" }, Variant {} };
+	std::vector<Variant> scalarCopies = scalars;
+	CHECK(scalarCopies == scalars);
+	CHECK(&scalarCopies[0].getType() == &scalars[0].getType());
+	CHECK(scalarCopies[2] == Variant {});
+	CHECK(scalarCopies[0] != scalarCopies[1]);
+	scalarCopies[1] = large;
+	CHECK(scalarCopies[1] == large);
+	scalarCopies[1] = scalars[0];
+	CHECK(scalarCopies[1].get<double>() == 1.5);
+}
+
+#if TY_REFLECTION_JSON
+TEST_CASE("JSON output") {
+	using namespace refl;
+	const std::vector<int> values { 1, 2, 3 };
+
+	SECTION("Compact") {
+		JSONOutputArchive outArchive { true, JSONFormat::compact };
+		outArchive.write("values", values);
+		CHECK(outArchive.saveToString() == R"({"values":[1,2,3]})");
+	}
+
+	SECTION("File") {
+		const char* fileName = "outputTest.json";
+		{
+			JSONOutputArchive outArchive { fileName, true, JSONFormat::compact };
+			REQUIRE(outArchive.isFileOpen());
+			outArchive.write("values", values);
+			CHECK(outArchive.closeFile());
+		}
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initializeFromFile(fileName));
+		CHECK(inArchive.read("values", std::vector<int> {}) == values);
+		std::remove(fileName);
+	}
+
+	SECTION("Missing directory") {
+		JSONOutputArchive outArchive { "missingDirectory/outputTest.json", true, JSONFormat::compact };
+		CHECK_FALSE(outArchive.isValid());
+		outArchive.write("values", values);
+		CHECK(outArchive.getBytesWritten() == 0);
+		CHECK_FALSE(outArchive.closeFile());
+	}
+}
+
+TEST_CASE("JSON stream") {
+	using namespace refl;
+	const char* json = R"({
+		"skipped": { "a": [1, 2, { "b": 3 }] },
+		"second": { "x": 4, "y": [5, 6] },
+		"first": "one",
+		"third": 7
+	})";
+
+	auto read = [](const JSONStreamInputArchive& inArchive) {
+		// Out of order members are buffered
+		CHECK(inArchive.read("first", std::string {}) == "one");
+		REQUIRE(inArchive.beginElement("second"));
+		CHECK(inArchive.isObject());
+		CHECK(inArchive.read("y", std::vector<int> {}) == std::vector<int> { 5, 6 });
+		CHECK(inArchive.read("x", 0) == 4);
+		inArchive.endElement();
+		CHECK(inArchive.read("third", 0) == 7);
+		CHECK_FALSE(inArchive.beginElement("fourth"));
+		CHECK(inArchive.getParseResult());
+	};
+
+	SECTION("Buffer") {
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(json));
+		read(inArchive);
+	}
+
+	SECTION("File") {
+		const char* fileName = "streamTest.json";
+		if (FILE* file = std::fopen(fileName, "w"); file) {
+			std::fputs(json, file);
+			std::fclose(file);
+		}
+		{
+			JSONStreamInputArchive inArchive;
+			REQUIRE(inArchive.initializeFromFile(fileName));
+			read(inArchive);
+		}
+		std::remove(fileName);
+	}
+
+	SECTION("Parse error") {
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(R"({ "first": 1, "second": ] })"));
+		CHECK(inArchive.read("first", 0) == 1);
+		CHECK_FALSE(inArchive.beginElement("second"));
+		CHECK_FALSE(inArchive.getParseResult());
+	}
+}
+#endif
+
+#if TY_REFLECTION_BINARY
+TEST_CASE("Binary archive") {
+	using namespace refl;
+	BinaryOutputArchive outArchive;
+	outArchive.write("first", 1);
+	outArchive.write("second", -2);
+	outArchive.writeAttribute("version", 3u);
+	// Long attribute names sharing a prefix are distinct keys
+	const std::string longName(300, 'a');
+	outArchive.writeAttribute((longName + "1").c_str(), 1u);
+	outArchive.writeAttribute((longName + "2").c_str(), 2u);
+	outArchive.write("name", "binary");
+	std::string content = outArchive.saveToString();
+
+	BinaryInputArchive inArchive;
+	REQUIRE(inArchive.initialize(content.data(), content.size()));
+	// Members can be read in any order
+	CHECK(inArchive.read("name", std::string {}) == "binary");
+	CHECK(inArchive.read("second", 0) == -2);
+	CHECK(inArchive.read("first", 0) == 1);
+	unsigned int version = 0;
+	CHECK(inArchive.readAttribute("version", version));
+	CHECK(version == 3);
+	CHECK(inArchive.readAttribute((longName + "2").c_str(), version));
+	CHECK(version == 2);
+	CHECK(inArchive.readAttribute((longName + "1").c_str(), version));
+	CHECK(version == 1);
+	CHECK_FALSE(inArchive.beginElement("third"));
+	unsigned int second = 0;
+	CHECK_FALSE(inArchive.read("second", second));
+
+	CHECK_FALSE(inArchive.initialize(content.data(), content.size() - 1));
+	CHECK_FALSE(inArchive.initialize(content.data(), 4));
+
+	// Strings without their null terminator are rejected
+	std::string corrupted = content;
+	corrupted[corrupted.find("binary") + 6] = 'x';
+	std::string name;
+	CHECK_FALSE((inArchive.initialize(corrupted.data(), corrupted.size()) && inArchive.read("name", name)));
+}
+
+TEST_CASE("Binary blob") {
+	using namespace refl;
+	const std::vector<Coords> points { { 1.f, 2.f, 3.f }, { 4.f, 5.f, 6.f }, { 7.f, 8.f, 9.f } };
+	BinaryOutputArchive       outArchive;
+	outArchive.write("name", "points");
+	outArchive.setKey("points");
+	outArchive.writeSpan(std::span { points.data(), points.size() });
+
+	auto read = [&](const BinaryInputArchive& inArchive) {
+		std::span<const Coords> span;
+		REQUIRE(inArchive.beginElement("points"));
+		CHECK(inArchive.getValueType() == ValueType::Blob);
+		REQUIRE(inArchive.readSpan(span));
+		inArchive.endElement();
+		REQUIRE(span.size() == points.size());
+		CHECK(std::equal(span.begin(), span.end(), points.begin()));
+		// Blobs are exposed in place, so their alignment is preserved
+		CHECK(reinterpret_cast<uintptr_t>(span.data()) % 16 == 0);
+	};
+
+	SECTION("Buffer") {
+		std::string        content = outArchive.saveToString();
+		BinaryInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
+
+	SECTION("Memory mapped file") {
+		const char* fileName = "blobTest.bin";
+		REQUIRE(outArchive.saveToFile(fileName));
+		{
+			BinaryInputArchive inArchive;
+			REQUIRE(inArchive.initializeFromFile(fileName));
+			read(inArchive);
+			std::string_view name;
+			REQUIRE(inArchive.beginElement("name"));
+			CHECK(inArchive.read(name));
+			inArchive.endElement();
+			CHECK(name == "points");
+		}
+		std::remove(fileName);
+	}
+}
+#endif
+
+TEST_CASE("Field properties") {
+	using namespace refl;
+	const auto& coordsType = static_cast<const StructType&>(getType<Coords>());
+	const auto  coordsProperties = coordsType.getProperties();
+	REQUIRE(coordsProperties.size() == 3);
+	CHECK(coordsProperties[0].isField());
+	CHECK(coordsProperties[0].getFieldOffset() == offsetof(Coords, x));
+	CHECK(coordsProperties[1].getFieldOffset() == offsetof(Coords, y));
+	CHECK(coordsProperties[2].getFieldOffset() == offsetof(Coords, z));
+
+	const auto& fogType = static_cast<const StructType&>(getType<Fog>());
+	CHECK_FALSE(fogType.getProperty("density")->isField());
+	// Arrays are copied through the accessors
+	CHECK_FALSE(fogType.getProperty("tag")->isField());
+
+	const auto& gameObjectType = static_cast<const StructType&>(getType<GameObject>());
+	CHECK_FALSE(gameObjectType.getProperty("lives")->isField());
+
+	const auto& hidingBaseType = static_cast<const StructType&>(getType<HidingBase>());
+	CHECK(hidingBaseType.getProperty("y")->getFieldOffset() == offsetof(HidingBase, y));
+	// Fields of classes that are not standard layout are copied through the accessors
+	static_assert(! std::is_standard_layout_v<HidingDerived>);
+	const auto& hidingDerivedType = static_cast<const StructType&>(getType<HidingDerived>());
+	CHECK_FALSE(hidingDerivedType.getProperty("a")->isField());
+}
+
+TEST_CASE("TypeDB") {
+	using namespace refl;
+	struct Unregistered {};
+
+	const Type* gameObjectType = tryGetType(Typhoon::getTypeId<GameObject>());
+	REQUIRE(gameObjectType);
+	CHECK(gameObjectType->getTypeId() == Typhoon::getTypeId<GameObject>());
+	const Type* colorType = tryGetType(Typhoon::getTypeId<Color>());
+	REQUIRE(colorType);
+	CHECK(colorType->getTypeId() == Typhoon::getTypeId<Color>());
+	CHECK(tryGetType(Typhoon::getTypeId<float>()) == &getType<float>());
+	CHECK(tryGetType(Typhoon::getTypeId<Unregistered>()) == nullptr);
+
+	const TypeDB& typeDB = detail::getTypeDB();
+	CHECK(typeDB.tryGetType("GameObject") == gameObjectType);
+	CHECK(typeDB.tryGetType(std::string_view { "ColorXYZ" }.substr(0, 5)) == colorType);
+	constexpr uint64_t colorHash = hashString("Color");
+	CHECK(typeDB.tryGetType("Color", colorHash) == colorType);
+	CHECK(typeDB.tryGetType("Unregistered") == nullptr);
+
+	const auto& derivedType = static_cast<const StructType&>(getType<DerivedGameObject>());
+	const auto& baseType = static_cast<const StructType&>(*gameObjectType);
+	CHECK(derivedType.findProperty("energy") == derivedType.getProperty("energy"));
+	CHECK(derivedType.findProperty("lives") == baseType.getProperty("lives"));
+	CHECK(derivedType.getProperty("lives") == nullptr);
+	constexpr uint64_t livesHash = hashString("lives");
+	CHECK(derivedType.findProperty("lives", livesHash) == baseType.getProperty("lives"));
+	CHECK(derivedType.findProperty(std::string_view { "livesXYZ" }.substr(0, 5)) == baseType.getProperty("lives"));
+	CHECK(derivedType.findProperty("unknown") == nullptr);
+	CHECK(derivedType.getAllProperties().size() == derivedType.getProperties().size() + baseType.getProperties().size());
+}
+
+TEST_CASE("TypeDB freeze") {
+	using namespace refl;
+	TypeDB&     typeDB = detail::getTypeDB();
+	const Type* colorType = typeDB.tryGetType(Typhoon::getTypeId<Color>());
+	const Type* seasonType = typeDB.tryGetType(Typhoon::getTypeId<SeasonType>());
+	REQUIRE(colorType);
+	REQUIRE(seasonType);
+
+	REQUIRE(freezeReflection());
+	CHECK(typeDB.isFrozen());
+	CHECK(typeDB.tryGetType(Typhoon::getTypeId<Color>()) == colorType);
+	CHECK(typeDB.tryGetType(Typhoon::getTypeId<GameObject>()) == typeDB.tryGetType("GameObject"));
+	CHECK(typeDB.tryGetType("Color") == colorType);
+	CHECK(typeDB.tryGetType("Unregistered") == nullptr);
+
+	const Property* property = static_cast<const StructType*>(colorType)->getProperty("g");
+	REQUIRE(property);
+	CHECK(std::string_view { property->getName() } == "g");
+	CHECK(static_cast<const StructType*>(colorType)->getProperty("w") == nullptr);
+	const auto& derivedType = static_cast<const StructType&>(getType<DerivedGameObject>());
+	CHECK(derivedType.findProperty("lives") == static_cast<const StructType&>(getType<GameObject>()).getProperty("lives"));
+	CHECK(derivedType.getProperty("lives") == nullptr);
+	CHECK(derivedType.findProperty("unknown") == nullptr);
+
+	const Enumerator* enumerator = static_cast<const EnumType*>(seasonType)->findEnumeratorByName("autumn");
+	REQUIRE(enumerator);
+	const SeasonType autumn = SeasonType::autumn;
+	CHECK(std::memcmp(enumerator->value, &autumn, sizeof autumn) == 0);
+	CHECK(static_cast<const EnumType*>(seasonType)->findEnumeratorByName("monsoon") == nullptr);
+
+	// The registry is read-only
+	CHECK_FALSE(typeDB.registerType(colorType));
+}
+
+#if TY_REFLECTION_INSTRUMENTATION
+TEST_CASE("Type stats") {
+	using namespace refl;
+	TypeDB&     typeDB = detail::getTypeDB();
+	const Type& fogType = getType<Fog>();
+	const Type& colorType = getType<Color>();
+	typeDB.resetTypeStats();
+
+	Fog fog;
+	setDensity(fog, 10.f);
+	setColor(fog, { 1.f, 0.5f, 0.5f });
+
+#if TY_REFLECTION_JSON
+	SECTION("JSON") {
+		JSONOutputArchive outArchive;
+		outArchive.write("fog", fog);
+		const TypeStats fogStats = typeDB.getTypeStats(fogType);
+		const TypeStats colorStats = typeDB.getTypeStats(colorType);
+		CHECK(fogStats.write.callCount == 1);
+		CHECK(colorStats.write.callCount == 1);
+		// Nested values are included
+		CHECK(colorStats.write.bytes > 0);
+		CHECK(fogStats.write.bytes > colorStats.write.bytes);
+		CHECK(fogStats.write.nanoseconds >= colorStats.write.nanoseconds);
+		// Getters return the properties in temporaries
+		CHECK(fogStats.write.scratchHighWater >= sizeof(Fog::ElvProfile));
+		CHECK(colorStats.write.scratchHighWater == 0);
+
+		const std::string      content = outArchive.saveToString();
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		Fog inFog;
+		REQUIRE(inArchive.read("fog", inFog));
+		CHECK(typeDB.getTypeStats(fogType).read.callCount == 1);
+		CHECK(typeDB.getTypeStats(fogType).read.bytes > 0);
+		CHECK(typeDB.getTypeStats(colorType).read.callCount == 1);
+
+		const std::string json = typeDB.exportTypeStats();
+		CHECK(json.find("\"name\": \"Fog\"") < json.find("\"name\": \"Color\""));
+		CHECK(json.find("\"name\": \"GameObject\"") == std::string::npos);
+	}
+#endif
+
+	SECTION("Clone") {
+		Fog clonedFog;
+		cloneObject(&clonedFog, fog);
+		CHECK(typeDB.getTypeStats(fogType).clone.callCount == 1);
+		typeDB.resetTypeStats();
+		CHECK(typeDB.getTypeStats(fogType).clone.callCount == 0);
+	}
+}
+#endif
+
+TEST_CASE("Thread contexts") {
+	using namespace refl;
+	// Threads share the registry, which must be read-only
+	REQUIRE(freezeReflection());
+
+	GameObject gameObject;
+	gameObject.setName("William");
+	gameObject.setActionFlags({ ActionFlags::running });
+	gameObject.setPosition({ 0.f, 1.f, 2.f });
+	gameObject.setMaterial(Material { "glossy", Color { 255, 255, 127 } });
+
+	auto equals = [](const GameObject& o0, const GameObject& o1) {
+		return o0.getLives() == o1.getLives() && o0.getActionFlags() == o1.getActionFlags() && o0.getName() == o1.getName()
+		    && o0.getPosition() == o1.getPosition() && o0.getMaterial() == o1.getMaterial();
+	};
+
+	// Catch assertions are not thread safe, so each thread reports a single result
+	constexpr int            threadCount = 8;
+	constexpr int            iterationCount = 200;
+	std::vector<char>        results(threadCount, 0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t] {
+			initThreadContext();
+			bool res = true;
+			for (int i = 0; i < iterationCount; ++i) {
+				GameObject object = gameObject;
+				object.setLives(t * iterationCount + i);
+#if TY_REFLECTION_JSON
+				JSONOutputArchive outArchive;
+				outArchive.write("gameObject", object);
+				const std::string content = outArchive.saveToString();
+				JSONInputArchive  inArchive;
+				GameObject        inObject;
+				res = res && inArchive.initialize(content.data()) && inArchive.read("gameObject", inObject) && equals(inObject, object);
+#endif
+				GameObject clonedObject;
+				cloneObject(&clonedObject, object);
+				res = res && equals(clonedObject, object);
+			}
+			deinitThreadContext();
+			results[t] = res;
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	for (int t = 0; t < threadCount; ++t) {
+		CHECK(results[t]);
+	}
+}
+
+// Record the chunks, to check that the work is split
+class CountingExecutor final : public refl::Executor {
+public:
+	size_t getConcurrency() const override {
+		return executor.getConcurrency();
+	}
+	void run(size_t taskCount, const std::function<void(size_t)>& task) override {
+		chunkCount += taskCount;
+		executor.run(taskCount, task);
+	}
+
+	refl::ThreadExecutor executor { 4 };
+	size_t               chunkCount = 0;
+};
+
+TEST_CASE("Parallel write") {
+	using namespace refl;
+	REQUIRE(freezeReflection());
+
+	std::vector<Material> materials(5000);
+	for (size_t i = 0; i < materials.size(); ++i) {
+		materials[i].name = std::to_string(i);
+		materials[i].color = Color { static_cast<float>(i), 0.5f, 0.25f };
+	}
+
+	auto write = [&](OutputArchive& archive, Executor* executor) {
+		if (executor) {
+			archive.write("materials", materials, *executor);
+		}
+		else {
+			archive.write("materials", materials);
+		}
+		return archive.saveToString();
+	};
+
+	auto read = [&](const InputArchive& archive) {
+		std::vector<Material> inMaterials;
+		REQUIRE(archive.read("materials", inMaterials));
+		CHECK(inMaterials == materials);
+	};
+
+	CountingExecutor executor;
+
+#if TY_REFLECTION_JSON
+	SECTION("JSON") {
+		JSONOutputArchive serialArchive { true, JSONFormat::compact };
+		JSONOutputArchive parallelArchive { true, JSONFormat::compact };
+		CHECK(write(parallelArchive, &executor) == write(serialArchive, nullptr));
+		CHECK(executor.chunkCount > 1);
+
+		// Chunks are compact in pretty printed archives
+		JSONOutputArchive prettyArchive;
+		std::string       content = write(prettyArchive, &executor);
+		JSONInputArchive  inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary") {
+		BinaryOutputArchive serialArchive;
+		BinaryOutputArchive parallelArchive;
+		// Key tokens are remapped, so that the output is the same
+		parallelArchive.write("version", 1);
+		serialArchive.write("version", 1);
+		std::string content = write(parallelArchive, &executor);
+		CHECK(content == write(serialArchive, nullptr));
+		CHECK(executor.chunkCount > 1);
+
+		BinaryInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive);
+	}
+
+	SECTION("Binary blobs") {
+		// Values are copied as they are only if their blobs stay aligned, which depends on the position of the array
+		std::vector<Fog> fogs(5000);
+		for (size_t i = 0; i < fogs.size(); ++i) {
+			fogs[i].density = static_cast<float>(i);
+			fogs[i].elevationProfile[i % fogs[i].elevationProfile.size()] = 1.f;
+		}
+		for (size_t padding = 0; padding < 16; ++padding) {
+			const std::string   name(padding, 'x');
+			BinaryOutputArchive serialArchive;
+			BinaryOutputArchive parallelArchive;
+			serialArchive.write("name", name);
+			parallelArchive.write("name", name);
+			serialArchive.write("fogs", fogs);
+			parallelArchive.write("fogs", fogs, executor);
+			std::string content = parallelArchive.saveToString();
+			CHECK(content == serialArchive.saveToString());
+
+			BinaryInputArchive inArchive;
+			REQUIRE(inArchive.initialize(content.data(), content.size()));
+			std::vector<Fog> inFogs;
+			REQUIRE(inArchive.read("fogs", inFogs));
+			CHECK(inFogs == fogs);
+		}
+		CHECK(executor.chunkCount > 1);
+	}
+
+	SECTION("Small containers") {
+		// Not worth splitting
+		const std::vector<Material> smallVector(10);
+		BinaryOutputArchive         archive;
+		archive.write("materials", smallVector, executor);
+		CHECK(executor.chunkCount == 0);
+	}
+#endif
+}
+
+TEST_CASE("Parallel read") {
+	using namespace refl;
+	REQUIRE(freezeReflection());
+
+	std::vector<Material> materials(5000);
+	for (size_t i = 0; i < materials.size(); ++i) {
+		materials[i].name = std::to_string(i);
+		materials[i].color = Color { static_cast<float>(i), 0.5f, 0.25f };
+	}
+	// Objects without the fields of materials
+	const std::vector<Coords> coords(materials.size());
+
+	auto read = [&](const InputArchive& archive, Executor& executor) {
+		// The container is resized to the number of elements
+		std::vector<Material> inMaterials(3);
+		REQUIRE(archive.read("materials", inMaterials, executor));
+		CHECK(inMaterials == materials);
+		// Fields missing from the archive do not keep the previous values, as when reading serially
+		std::vector<Material> staleMaterials(coords.size(), Material { "stale", Color { 0.f, 0.f, 0.f } });
+		REQUIRE(archive.read("coords", staleMaterials, executor));
+		CHECK(std::all_of(staleMaterials.begin(), staleMaterials.end(), [](const Material& m) { return m == Material {}; }));
+	};
+
+	CountingExecutor executor;
+
+#if TY_REFLECTION_JSON
+	SECTION("JSON") {
+		JSONOutputArchive outArchive;
+		outArchive.write("materials", materials);
+		outArchive.write("coords", coords);
+		std::string      content = outArchive.saveToString();
+		JSONInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive, executor);
+		CHECK(executor.chunkCount > 1);
+	}
+
+	SECTION("JSON stream") {
+		// Streams cannot be forked
+		JSONOutputArchive outArchive;
+		outArchive.write("materials", materials);
+		outArchive.write("coords", coords);
+		std::string            content = outArchive.saveToString();
+		JSONStreamInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data()));
+		read(inArchive, executor);
+		CHECK(executor.chunkCount == 0);
+	}
+#endif
+
+#if TY_REFLECTION_BINARY
+	SECTION("Binary") {
+		BinaryOutputArchive outArchive;
+		outArchive.write("materials", materials);
+		outArchive.write("coords", coords);
+		std::string        content = outArchive.saveToString();
+		BinaryInputArchive inArchive;
+		REQUIRE(inArchive.initialize(content.data(), content.size()));
+		read(inArchive, executor);
+		CHECK(executor.chunkCount > 1);
+	}
+#endif
+}
+
 void registerUserTypes() {
 	BEGIN_REFLECTION()
 
@@ -805,6 +2020,28 @@ void registerUserTypes() {
 	ENUMERATOR(winter)
 	END_ENUM();
 
+	BEGIN_ENUM(Priority)
+	ENUMERATOR(lowest)
+	ENUMERATOR(low)
+	ENUMERATOR(normal)
+	ENUMERATOR(high)
+	ENUMERATOR(urgent)
+	ENUMERATOR(highest)
+	END_ENUM();
+
+	BEGIN_STRUCT(Particle);
+	FIELD(position);
+	FIELD(color);
+	FIELD(season);
+	FIELD(age);
+	END_STRUCT();
+
+	// Registers the pmr containers, as the registry may be frozen by the time the Arena test runs
+	BEGIN_STRUCT(ArenaDocument);
+	FIELD(names);
+	FIELD(table);
+	END_STRUCT();
+
 	BEGIN_STRUCT(Material);
 	FIELD(name);
 	FIELD(color).SEMANTIC(refl::Semantic::color);
@@ -826,5 +2063,21 @@ void registerUserTypes() {
 	PROPERTY("energy", getEnergy, setEnergy);
 	END_CLASS();
 
+	BEGIN_STRUCT(StringViews);
+	FIELD(first);
+	FIELD(second);
+	FIELD(third);
+	END_STRUCT();
+
+	BEGIN_STRUCT(HidingBase);
+	FIELD(x);
+	FIELD(y);
+	END_STRUCT();
+
+	BEGIN_SUB_CLASS(HidingDerived, HidingBase);
+	FIELD(x);
+	FIELD(a);
+	END_CLASS();
+
 	END_REFLECTION();
 }
@@ -13,6 +13,10 @@ bool operator==(const Color& a, const Color& b) {
 	return a.r == b.r && a.g == b.g && a.b == b.b;
 }
 
+bool operator==(const Particle& a, const Particle& b) {
+	return a.position == b.position && a.color == b.color && a.season == b.season && a.age == b.age && a.cache == b.cache;
+}
+
 bool operator==(const Material& a, const Material& b) {
 	return a.name == b.name && a.color == b.color;
 }
@@ -4,7 +4,10 @@
 #include <reflection/fwdDecl.h>
 
 #include <array>
+#include <map>
+#include <memory_resource>
 #include <string>
+#include <vector>
 
 enum class ActionFlags : uint16_t {
 	running = 0x1,
@@ -21,6 +24,16 @@ enum class SeasonType {
 	winter,
 };
 
+// Sparse values, with an alias
+enum class Priority : int16_t {
+	lowest = -100,
+	low = -10,
+	normal = 0,
+	high = 10,
+	urgent = 10,
+	highest = 100,
+};
+
 struct Coords {
 	float x;
 	float y;
@@ -35,6 +48,23 @@ struct Color {
 
 bool operator==(const Color& a, const Color& b);
 
+// Plain data. The cache is not reflected, so it is neither serialized nor cloned
+struct Particle {
+	Coords     position {};
+	Color      color {};
+	SeasonType season = SeasonType::spring;
+	float      age = 0.f;
+	int        cache = 0;
+};
+
+bool operator==(const Particle& a, const Particle& b);
+
+// Document read into an arena
+struct ArenaDocument {
+	std::pmr::vector<std::pmr::string>                      names;
+	std::pmr::map<std::pmr::string, std::pmr::vector<int>> table;
+};
+
 // Resource with custom loading and saving procedures
 struct Material {
 	std::string name;
@@ -110,6 +140,24 @@ private:
 	float energy = 0.f;
 };
 
+// Members that point into the source of the archive
+struct StringViews {
+	std::string_view first;
+	std::string_view second;
+	const char*      third = nullptr;
+};
+
+// Derived struct with a field of the same name as a field of its base
+struct HidingBase {
+	int x = 0;
+	int y = 0;
+};
+
+struct HidingDerived : HidingBase {
+	int x = 0;
+	int a = 0;
+};
+
 // C style structure and API
 struct Fog {
 	using ElvProfile = std::array<float, 8>;